@@ -0,0 +1,66 @@
+// Micro-benchmark for the batch collision kernel.
+//
+// Build from the repository root, no openFrameworks needed:
+//   g++ -O2 -std=c++11 -Isrc/core bench/collide_bench.cpp src/core/CollideKernel.cpp -o collide_bench
+//
+// Reports targets tested per second for each kernel at 1k, 10k and 100k
+// targets spread over the play field.
+
+#include "CollideKernel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+typedef int(*CollideFn)(float, float, float, const float *, const float *, int, uint32_t *);
+
+static double run(CollideFn fn, const vector<float> &px, const vector<float> &py, vector<uint32_t> &mask, int &hits) {
+	int n = px.size();
+	// Enough queries for roughly 50M target tests per case.
+	int queries = max(10, 50000000 / n);
+	hits = 0;
+	auto start = chrono::steady_clock::now();
+	for (int q = 0; q < queries; q++) {
+		float x = (q * 37) % 375;
+		float y = (q * 91) % 667;
+		hits += fn(x, y, 20, px.data(), py.data(), n, mask.data());
+	}
+	chrono::duration<double> secs = chrono::steady_clock::now() - start;
+	return (double)queries * n / secs.count();
+}
+
+int main() {
+	printf("dispatch picks: %s\n", collideKernelName());
+	printf("%10s %8s %16s\n", "targets", "kernel", "targets/sec");
+
+	mt19937 rng(134);
+	uniform_real_distribution<float> ux(0, 375), uy(0, 667);
+	int sizes[] = { 1000, 10000, 100000 };
+	for (int n : sizes) {
+		vector<float> px(n), py(n);
+		for (int i = 0; i < n; i++) {
+			px[i] = ux(rng);
+			py[i] = uy(rng);
+		}
+		vector<uint32_t> mask((n + 31) / 32);
+
+		struct { const char *name; CollideFn fn; } kernels[] = {
+			{ "scalar", collidePointsScalar },
+			{ "sse", collidePointsSSE },
+			{ "avx2", cpuHasAVX2() ? collidePointsAVX2 : NULL },
+		};
+		int expected = -1;
+		for (auto &k : kernels) {
+			if (k.fn == NULL) continue;
+			int hits;
+			double rate = run(k.fn, px, py, mask, hits);
+			printf("%10d %8s %16.3e%s\n", n, k.name, rate, (expected != -1 && hits != expected) ? "  MISMATCH" : "");
+			if (expected == -1) expected = hits;
+		}
+	}
+	return 0;
+}
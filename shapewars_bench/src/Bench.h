@@ -0,0 +1,138 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Minimal micro-benchmark harness. Cases are registered with a list of
+// argument sets; each runs with a growing iteration count until it takes at
+// least the minimum time. Results print as a table or as JSON in the same
+// layout Google Benchmark writes, so its compare tools work on them.
+
+// Passed to a case. Loop with `while (state.next())`, pause the timer around
+// per-iteration setup that shouldn't be counted.
+//
+class BenchState {
+public:
+	BenchState(const vector<int64_t> &a, int64_t n) : args(a), iterations(n) {}
+
+	int64_t arg(int i) const { return args[i]; }
+	void setItems(int64_t n) { items = n; }
+
+	bool next() {
+		if (done == 0) { resume(); }
+		if (done++ < iterations) return true;
+		pause();
+		return false;
+	}
+	void pause() {
+		realNs += chrono::duration<double, nano>(chrono::steady_clock::now() - startReal).count();
+		cpuNs += (clock() - startCpu) * (1e9 / CLOCKS_PER_SEC);
+	}
+	void resume() {
+		startReal = chrono::steady_clock::now();
+		startCpu = clock();
+	}
+
+	vector<int64_t> args;
+	int64_t iterations;
+	int64_t done = 0;
+	int64_t items = 0;		// items processed per iteration
+	double realNs = 0, cpuNs = 0;
+
+private:
+	chrono::steady_clock::time_point startReal;
+	clock_t startCpu;
+};
+
+struct BenchCase {
+	string name;
+	vector<vector<int64_t>> args;
+	function<void(BenchState &)> fn;
+};
+
+struct BenchResult {
+	string name;
+	int64_t iterations;
+	double realNs, cpuNs;	// per iteration
+	double itemsPerSecond;
+};
+
+class BenchRunner {
+public:
+	void add(const string &name, const vector<vector<int64_t>> &args, function<void(BenchState &)> fn) {
+		cases.push_back({ name, args, fn });
+	}
+
+	// Run every case whose name contains filter.
+	void run(const string &filter = "") {
+		for (BenchCase &c : cases) {
+			for (const vector<int64_t> &a : c.args) {
+				string name = c.name;
+				for (int64_t v : a) { name += "/" + to_string(v); }
+				if (name.find(filter) == string::npos) continue;
+				results.push_back(runOne(name, c.fn, a));
+				BenchResult &r = results.back();
+				fprintf(stderr, "%-44s %12.0f ns %12lld it %14.4g items/s\n", r.name.c_str(), r.realNs, (long long)r.iterations, r.itemsPerSecond);
+			}
+		}
+	}
+
+	bool writeJson(const string &path, const string &executable) {
+		FILE *f = fopen(path.c_str(), "w");
+		if (f == NULL) return false;
+		time_t now = time(NULL);
+		char date[32];
+		strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+		fprintf(f, "{\n  \"context\": {\n    \"date\": \"%s\",\n    \"executable\": \"%s\",\n", date, executable.c_str());
+#ifdef NDEBUG
+		fprintf(f, "    \"library_build_type\": \"release\"\n  },\n");
+#else
+		fprintf(f, "    \"library_build_type\": \"debug\"\n  },\n");
+#endif
+		fprintf(f, "  \"benchmarks\": [\n");
+		for (int i = 0; i < results.size(); i++) {
+			BenchResult &r = results[i];
+			fprintf(f, "    {\n      \"name\": \"%s\",\n      \"run_name\": \"%s\",\n      \"run_type\": \"iteration\",\n", r.name.c_str(), r.name.c_str());
+			fprintf(f, "      \"iterations\": %lld,\n      \"real_time\": %.3f,\n      \"cpu_time\": %.3f,\n      \"time_unit\": \"ns\"",
+				(long long)r.iterations, r.realNs, r.cpuNs);
+			if (r.itemsPerSecond > 0) { fprintf(f, ",\n      \"items_per_second\": %.6e", r.itemsPerSecond); }
+			fprintf(f, "\n    }%s\n", i + 1 < results.size() ? "," : "");
+		}
+		fprintf(f, "  ]\n}\n");
+		fclose(f);
+		return true;
+	}
+
+	double minTime = 0.5;	// seconds each case runs for at least
+	vector<BenchCase> cases;
+	vector<BenchResult> results;
+
+private:
+	BenchResult runOne(const string &name, function<void(BenchState &)> &fn, const vector<int64_t> &args) {
+		// Grow the iteration count until a run is long enough to trust.
+		int64_t n = 1;
+		while (true) {
+			BenchState state(args, n);
+			fn(state);
+			double secs = state.realNs * 1e-9;
+			if (secs >= minTime || n >= 1000000000) {
+				BenchResult r;
+				r.name = name;
+				r.iterations = n;
+				r.realNs = state.realNs / n;
+				r.cpuNs = state.cpuNs / n;
+				r.itemsPerSecond = state.items > 0 ? state.items * n / secs : 0;
+				return r;
+			}
+			// Aim a little past the minimum, at most 10x more each round.
+			double scale = secs > 0 ? minTime * 1.4 / secs : 10;
+			n = max(n + 1, (int64_t)(n * min(scale, 10.0)));
+		}
+	}
+};
@@ -0,0 +1,274 @@
+#include "ofMain.h"
+#include "Bench.h"
+#include "Simulation.h"
+
+#include <climits>
+#include <cstring>
+
+// Micro-benchmarks for the simulation hot paths. No window is opened and
+// nothing is drawn; everything runs on the headless core in ../src/core.
+//
+// usage: shapewars_bench [--filter <text>] [--json <file>] [--min-time <sec>]
+//
+// Results go to stderr as a table, and with --json to a file in Google
+// Benchmark's format for tracking regressions between builds.
+
+// Fill a sprite system with n immortal sprites spread over the play field.
+static void fillSprites(SpriteSystem &sys, int n, Random &rng) {
+	sys.clear();
+	sys.reserve(n);
+	for (int i = 0; i < n; i++) {
+		glm::vec3 pos(rng.range(0, 375), rng.range(0, 667), 0);
+		glm::vec3 vel(rng.range(-100, 100), rng.range(-1000, 0), 0);
+		sys.spawn(pos, vel, -1, 0);
+	}
+}
+
+// The ship every bench fleet copies.
+static Emitter *shipTemplate() {
+	static SpriteSystem shots;
+	static Emitter e(&shots);
+	e.setVelocity(ofVec3f(0, -100, 0));
+	e.isEnemy = true;
+	return &e;
+}
+
+// The built-in paths plus a spline, baked for the default field.
+static PathLibrary &benchPaths() {
+	static PathLibrary lib;
+	if (lib.empty()) {
+		lib.parse(DEFAULT_PATHS);
+		lib.parse("swoop catmull 0 0 -120 0.2 100 0.45 -60 0.7 0 1\n");
+		lib.build(667);
+	}
+	return lib;
+}
+
+// A fleet flying the named path, or straight down for "".
+static unique_ptr<MamaEmitter> makeFleet(const string &path, int capacity) {
+	unique_ptr<MamaEmitter> mama = make_unique<MamaEmitter>(shipTemplate(), capacity);
+	mama->library = &benchPaths();
+	mama->emitter.path = benchPaths().find(path);
+	return mama;
+}
+
+// Tick the bench fleets are filled at. Ships are back dated from here, so it
+// leaves room for the longest flight down the field.
+const Tick FLEET_EPOCH = 60 * TICK_RATE;
+
+// Fill a fleet with n ships spread down its path, each firing shots.
+static void fillFleet(MamaEmitter &mama, int n, int shots, Random &rng) {
+	Emitter *e = &mama.emitter;
+	e->duration = 1e9;
+	for (int i = 0; i < n; i++) {
+		// Back date the ship by the time it took to fly this far.
+		float s = rng.range(0, 667);
+		e->birth = FLEET_EPOCH - (Tick)(s / e->pathSpeed * TICK_RATE);
+		e->setPosition(mama.pathPoint(*e, s));
+		Emitter *ship = mama.emitters.get(mama.emitters.add(*e));
+		fillSprites(*ship->sys, shots, rng);
+	}
+}
+
+static void spriteUpdate(BenchState &state) {
+	Random rng(1, 0);
+	SpriteSystem sys;
+	fillSprites(sys, state.arg(0), rng);
+	Tick now = 0;
+	while (state.next()) { sys.update(now++); }
+	state.setItems(state.arg(0));
+}
+
+// Query random points. Sprites that get hit are put back elsewhere so the
+// count stays fixed.
+static void spriteRemoveNear(BenchState &state) {
+	Random rng(2, 0);
+	SpriteSystem sys;
+	int n = state.arg(0);
+	fillSprites(sys, n, rng);
+	while (state.next()) {
+		ofVec3f p(rng.range(0, 375), rng.range(0, 667), 0);
+		if (sys.removeNear(p, 10)) {
+			state.pause();
+			sys.spawn(glm::vec3(rng.range(0, 375), rng.range(0, 667), 0), glm::vec3(0, 0, 0), -1, 0);
+			state.resume();
+		}
+	}
+	state.setItems(n);
+}
+
+// Time wraps every few seconds so the ships stay on their paths.
+static void mamaMove(BenchState &state, const string &path) {
+	Random rng(3, 0);
+	int n = state.arg(0);
+	unique_ptr<MamaEmitter> mama = makeFleet(path, n);
+	fillFleet(*mama, n, 0, rng);
+	Tick tick = 0;
+	while (state.next()) {
+		mama->move(FLEET_EPOCH + tick);
+		tick = (tick + 1) % (3 * TICK_RATE);
+	}
+	state.setItems(n);
+}
+
+static void mamaRotation(BenchState &state) {
+	Random rng(4, 0);
+	int n = state.arg(0);
+	unique_ptr<MamaEmitter> mama = makeFleet("wave", n);
+	fillFleet(*mama, n, 0, rng);
+	mama->target = glm::vec3(187, 500, 0);
+	while (state.next()) { mama->rotation(); }
+	state.setItems(n);
+}
+
+// Debris under the pool's shared gravity plus the radial impulse. The
+// impulse normally kicks each particle once, here it is re-applied every
+// update. With bVirtual the same forces also go through the virtual slow path.
+static void explosionUpdate(BenchState &state, bool bVirtual) {
+	Random rng(5, 0);
+	int n = state.arg(0);
+	ExplosionPool pool(1, n);
+	pool.setRandom(&rng);
+	GravityForce gravity(ofVec3f(0, 0, 0));
+	ImpulseRadialForce radial(2000.0);
+	radial.rng = &rng;
+	if (bVirtual) {
+		pool.custom.push_back(&gravity);
+		pool.custom.push_back(&radial);
+	}
+	for (int i = 0; i < n; i++) {
+		Debris d;
+		d.position = ofVec3f(rng.range(0, 375), rng.range(0, 667), 0);
+		d.velocity = ofVec3f(rng.range(-100, 100), rng.range(-100, 100), 0);
+		d.lifespan = -1;
+		pool.debris.push_back(d);
+	}
+	Tick now = 0;
+	while (state.next()) {
+		pool.kick(0);
+		pool.update(now++);
+	}
+	state.setItems(n);
+}
+
+// Grid rebuild plus all three collision passes with arg(0) enemy ships
+// across three fleets, arg(1) shots per ship and 64 player shots. Ships and
+// shots that get hit are restored between iterations, untimed.
+static void collisions(BenchState &state) {
+	int ships = state.arg(0), shots = state.arg(1);
+	Random rng(6, 0);
+	TickClock clock;
+	Simulation sim;
+	sim.setup(&clock, 6, Viewport(), SimAssets());
+	sim.start();
+	sim.enemy.clear();
+	for (int m = 0; m < 3; m++) {
+		unique_ptr<MamaEmitter> mama = makeFleet(m == 2 ? "line" : "wave", ships / 3 + 1);
+		fillFleet(*mama, ships / 3, shots, rng);
+		sim.enemy.push_back(move(mama));
+	}
+	fillSprites(*sim.player->sys, 64, rng);
+	SpriteSystem playerShots = *sim.player->sys;
+
+	while (state.next()) {
+		sim.buildCollisionGrids();
+		sim.powerCollisions(0);
+		sim.playerCollisions(0);
+		sim.checkCollisions(0);
+
+		state.pause();
+		for (unique_ptr<MamaEmitter> &e : sim.enemy) {
+			for (int i = 0; i < e->emitters.size(); i++) { e->emitters[i].drawable = true; }
+		}
+		*sim.player->sys = playerShots;
+		sim.explosions.clear();
+		sim.lives = 10;
+		sim.bGameOver = false;
+		state.resume();
+	}
+	state.setItems(ships * (shots + 1) + 64);
+}
+
+// A level of n wave fleets spread across the field, each launching a ship
+// every half second, alternating wave and wave-tight.
+static string stressLevel(int n) {
+	string text = "archetype grunt 100 2 2 aimed\nloop 15\n";
+	for (int m = 0; m < n; m++) {
+		string name = "f" + ofToString(m);
+		text += "fleet " + name + " " + ofToString((m + 0.5) / n) + (m % 2 ? " mirror\n" : "\n");
+		text += "spawn 0 " + name + " grunt wave 15 0.5\n";
+		text += "spawn 7.5 " + name + " grunt wave-tight 15 0.5\n";
+	}
+	return text;
+}
+
+// arg(0) fleets of wave ships across the field updated on arg(1) threads,
+// after ten seconds of play so each fleet is at its usual size and firing.
+static void fleetUpdate(BenchState &state) {
+	int fleets = state.arg(0);
+	TickClock clock;
+	Simulation sim;
+	sim.level.parse(stressLevel(fleets));
+	sim.setup(&clock, 7, Viewport(), SimAssets());
+	sim.setThreads(state.arg(1));
+	sim.start();
+	for (int i = 0; i < 10 * TICK_RATE; i++) {
+		sim.updateFleets(clock.tick());
+		clock.advance();
+	}
+	while (state.next()) {
+		sim.updateFleets(clock.tick());
+		clock.advance();
+	}
+	state.setItems(fleets);
+}
+
+// Whole ticks, every phase of the task graph, with arg(0) fleets on arg(1)
+// threads. The player keeps firing and can't die.
+static void simTick(BenchState &state) {
+	TickClock clock;
+	Simulation sim;
+	sim.level.parse(stressLevel(state.arg(0)));
+	sim.setup(&clock, 8, Viewport(), SimAssets());
+	sim.setThreads(state.arg(1));
+	sim.start();
+	sim.lives = INT_MAX;
+	TickInput input;
+	input.shoot = true;
+	for (int i = 0; i < 10 * TICK_RATE; i++) { sim.tick(input); }
+	while (state.next()) { sim.tick(input); }
+	state.setItems(1);
+}
+
+//========================================================================
+int main(int argc, char *argv[]) {
+	BenchRunner bench;
+	string filter, json;
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (strcmp(argv[i], "--filter") == 0) { filter = argv[i + 1]; }
+		else if (strcmp(argv[i], "--json") == 0) { json = argv[i + 1]; }
+		else if (strcmp(argv[i], "--min-time") == 0) { bench.minTime = atof(argv[i + 1]); }
+	}
+
+	vector<vector<int64_t>> sprites = { { 100 }, { 1000 }, { 10000 }, { 100000 }, { 1000000 } };
+	vector<vector<int64_t>> fleet = { { 16 }, { 64 }, { 256 } };
+	bench.add("SpriteSystem::update", sprites, spriteUpdate);
+	bench.add("SpriteSystem::removeNear", sprites, spriteRemoveNear);
+	bench.add("MamaEmitter::move<straight>", fleet, [](BenchState &s) { mamaMove(s, ""); });
+	bench.add("MamaEmitter::move<wave>", fleet, [](BenchState &s) { mamaMove(s, "wave"); });
+	bench.add("MamaEmitter::move<line>", fleet, [](BenchState &s) { mamaMove(s, "line"); });
+	bench.add("MamaEmitter::move<swoop>", fleet, [](BenchState &s) { mamaMove(s, "swoop"); });
+	bench.add("MamaEmitter::rotation", fleet, mamaRotation);
+	bench.add("ExplosionPool::update", { { 100 }, { 1000 }, { 10000 } }, [](BenchState &s) { explosionUpdate(s, false); });
+	bench.add("ExplosionPool::update<virtual>", { { 100 }, { 1000 }, { 10000 } }, [](BenchState &s) { explosionUpdate(s, true); });
+	bench.add("Simulation::updateFleets", { { 3, 1 }, { 32, 1 }, { 32, 2 }, { 32, 4 }, { 128, 1 }, { 128, 4 } }, fleetUpdate);
+	bench.add("Simulation::tick", { { 3, 1 }, { 3, 4 }, { 32, 1 }, { 32, 4 } }, simTick);
+	bench.add("Simulation::collisions", { { 30, 0 }, { 30, 10 }, { 90, 10 }, { 192, 10 }, { 192, 50 } }, collisions);
+
+	bench.run(filter);
+	if (json != "" && !bench.writeJson(json, argv[0])) {
+		fprintf(stderr, "could not write %s\n", json.c_str());
+		return 1;
+	}
+	return 0;
+}
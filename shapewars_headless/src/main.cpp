@@ -0,0 +1,131 @@
+#include "ofMain.h"
+#include "Replay.h"
+#include "Simulation.h"
+
+#include <climits>
+#include <cstring>
+
+// Runs the game without a window, graphics or sound. The player sits in the
+// middle of the field firing while the fleets attack, for a fixed number of
+// ticks, then reports how fast the ticks ran.
+//
+// With --replay it plays a session recorded by the game instead, checking
+// the state hash every tick, and reports the first tick that differs.
+//
+// --threads spreads the fleet updates over that many threads. The game plays
+// out the same on any number.
+//
+// --level plays a level file instead of the built-in level. A replay needs
+// the level it was recorded on, and is refused on any other.
+//
+// usage: shapewars_headless [--threads <n>] [--level <file>] [ticks] [seed]
+//        shapewars_headless [--threads <n>] [--level <file>] --replay <file>
+
+static void report(Simulation &sim, int ticks, double secs) {
+	int ships = 0, shots = 0;
+	for (unique_ptr<MamaEmitter> &e : sim.enemy) {
+		ships += e->emitters.size();
+		for (int i = 0; i < e->emitters.size(); i++) { shots += e->emitters[i].sys->size(); }
+	}
+	printf("seed %llu\n", (unsigned long long)sim.seed);
+	printf("%d ticks in %.3f s (%.0f ticks/s)\n", ticks, secs, ticks / secs);
+	printf("score %.0f, %d enemy ships, %d enemy shots, %d player shots\n",
+		sim.score, ships, shots, sim.player->sys->size());
+
+	// Zone times averaged over the ticks still in the profiler's ring.
+	Profiler &p = Profiler::get();
+	vector<ProfileFrame> frames;
+	p.latest(PROFILE_RING_SIZE, frames);
+	for (int z = 0; z < p.zones.size() && !frames.empty(); z++) {
+		float sum = 0;
+		for (ProfileFrame &f : frames) { sum += f.ms[z]; }
+		printf("  %-18s %8.4f ms/tick\n", p.zones[z].c_str(), sum / frames.size());
+	}
+}
+
+// Play back a recording. Returns non-zero if the game did not match it.
+static int replay(const char *path, int threads, const char *level) {
+	Recording rec;
+	if (!rec.load(path)) {
+		printf("could not read replay %s\n", path);
+		return 2;
+	}
+
+	TickClock clock;
+	Simulation sim;
+	if (level && !sim.level.load(level)) {
+		printf("could not read level %s\n", level);
+		return 2;
+	}
+	sim.setup(&clock, rec.seed, rec.view, SimAssets());
+	if (sim.dataHash() != rec.dataHash) {
+		printf("replay %s was recorded on a different level or paths\n", path);
+		return 2;
+	}
+	sim.setThreads(threads);
+	sim.start();
+
+	auto begin = chrono::steady_clock::now();
+	while (sim.running() && sim.ticks < rec.hashes.size()) {
+		sim.tick(rec.input(sim.ticks));
+		rec.verify(sim.ticks - 1, sim.stateHash());
+		Profiler::get().endFrame();
+	}
+	double secs = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+
+	report(sim, sim.ticks, secs);
+	if (sim.ticks < rec.hashes.size()) {
+		printf("game ended at tick %llu, recording has %d\n", (unsigned long long)sim.ticks, (int)rec.hashes.size());
+		return 1;
+	}
+	if (rec.divergedAt >= 0) {
+		printf("DIVERGED at tick %d\n", rec.divergedAt);
+		return 1;
+	}
+	printf("in sync for all %d ticks\n", (int)rec.hashes.size());
+	return 0;
+}
+
+//========================================================================
+int main(int argc, char *argv[]) {
+	int threads = 1;
+	const char *level = NULL;
+	while (argc > 2 && strncmp(argv[1], "--", 2) == 0 && strcmp(argv[1], "--replay") != 0) {
+		if (strcmp(argv[1], "--threads") == 0) { threads = max(1, atoi(argv[2])); }
+		else if (strcmp(argv[1], "--level") == 0) { level = argv[2]; }
+		else {
+			printf("unknown option %s\n", argv[1]);
+			return 2;
+		}
+		argc -= 2;
+		argv += 2;
+	}
+	if (argc > 2 && strcmp(argv[1], "--replay") == 0) { return replay(argv[2], threads, level); }
+
+	int ticks = argc > 1 ? atoi(argv[1]) : 60 * 60;
+	uint64_t seed = argc > 2 ? strtoull(argv[2], NULL, 10) : 1;
+
+	TickClock clock;
+	Simulation sim;
+	if (level && !sim.level.load(level)) {
+		printf("could not read level %s\n", level);
+		return 2;
+	}
+	sim.setup(&clock, seed, Viewport(), SimAssets());
+	sim.setThreads(threads);
+	sim.start();
+	sim.lives = INT_MAX;	// keep playing no matter how often the player is hit
+
+	TickInput input;
+	input.shoot = true;
+
+	auto begin = chrono::steady_clock::now();
+	for (int i = 0; i < ticks; i++) {
+		sim.tick(input);
+		Profiler::get().endFrame();
+	}
+	double secs = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+
+	report(sim, ticks, secs);
+	return 0;
+}
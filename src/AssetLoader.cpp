@@ -0,0 +1,100 @@
+#include "AssetLoader.h"
+
+void AssetLoader::texture(const string &path, int w, int h) {
+	items.push_back(make_unique<Item>());
+	items.back()->kind = LoadTexture;
+	items.back()->path = path;
+	items.back()->w = w;
+	items.back()->h = h;
+}
+
+void AssetLoader::atlas(const vector<AtlasImage> &images) {
+	items.push_back(make_unique<Item>());
+	items.back()->kind = LoadAtlas;
+	items.back()->images = images;
+}
+
+// A sound with players for up to voices copies of it at once, each one its
+// own item.
+void AssetLoader::sound(const string &path, int voices) {
+	for (int i = 0; i < max(voices, 1); i++) {
+		items.push_back(make_unique<Item>());
+		items.back()->kind = LoadSound;
+		items.back()->path = path;
+	}
+}
+
+void AssetLoader::start(int threads) {
+	begin = chrono::steady_clock::now();
+	for (int i = 0; i < threads; i++) { workers.emplace_back(&AssetLoader::run, this); }
+}
+
+// Workers take the next item until there are none left.
+void AssetLoader::run() {
+	for (int i = next++; i < items.size(); i = next++) {
+		load(*items[i]);
+		items[i]->ready.store(true, memory_order_release);
+	}
+}
+
+// The part of loading that needs no GL context. Sounds are left for the
+// main thread.
+//
+void AssetLoader::load(Item &item) {
+	switch (item.kind) {
+	case LoadTexture:
+		AssetRegistry::load(item.pixels, item.path, item.w, item.h);
+		break;
+	case LoadAtlas:
+		if (!AssetRegistry::pack(item.images, item.page)) {
+			ofLogError("AssetLoader") << "unable to pack atlas";
+		}
+		break;
+	case LoadSound:
+		break;
+	}
+}
+
+// Items go in in order, so one still loading holds up the ones after it.
+// Pixels are freed once uploaded. Sound players are loaded here, decoding
+// the whole file on this thread, which the budget can't split up: a sound
+// only goes in first in a call, and ends it. At least one item goes in per
+// call.
+//
+bool AssetLoader::update(AssetRegistry &assets, float budgetMs) {
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	int first = added;
+	while (added < items.size() && items[added]->ready.load(memory_order_acquire)) {
+		Item &item = *items[added];
+		if (item.kind == LoadSound && added > first) break;
+		switch (item.kind) {
+		case LoadTexture:
+			assets.addTexture(item.path, item.w, item.h, item.pixels);
+			item.pixels.clear();
+			break;
+		case LoadAtlas:
+			if (item.page.pixels.isAllocated()) { assets.addAtlas(item.page); }
+			item.page.pixels.clear();
+			break;
+		case LoadSound:
+			assets.addVoice(item.path);
+			ofLogNotice("AssetLoader") << "loaded " << item.path << " in " << chrono::duration<float, milli>(chrono::steady_clock::now() - start).count() << " ms";
+			break;
+		}
+		added++;
+		if (item.kind == LoadSound || chrono::duration<float, milli>(chrono::steady_clock::now() - start).count() > budgetMs) break;
+	}
+	if (!done()) return false;
+
+	if (!workers.empty()) {
+		join();
+		ms = chrono::duration<float, milli>(chrono::steady_clock::now() - begin).count();
+		ofLogNotice("AssetLoader") << "loaded " << items.size() << " assets in " << ms << " ms";
+	}
+	return true;
+}
+
+void AssetLoader::join() {
+	for (thread &t : workers) { t.join(); }
+	workers.clear();
+}
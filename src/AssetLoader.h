@@ -0,0 +1,56 @@
+#pragma once
+
+#include "AssetRegistry.h"
+
+#include <atomic>
+#include <thread>
+
+// Loads assets for an AssetRegistry in the background. Images are decoded
+// (and atlases packed) on worker threads and uploaded by update() on the
+// main thread, a few per frame, so the app keeps drawing while it loads.
+// Sounds are loaded by update() too, a player per voice and one per frame,
+// as the sound players aren't safe to load off the main thread. Assets are
+// handed over in the order they were asked for.
+//
+class AssetLoader {
+public:
+	~AssetLoader() { join(); }
+
+	// Queue assets, before start().
+	void texture(const string &path, int w = 0, int h = 0);
+	void atlas(const vector<AtlasImage> &images);
+	void sound(const string &path, int voices = 1);
+
+	void start(int threads = 2);
+
+	// Main thread, once a frame: add what has finished to the registry,
+	// spending about budgetMs. Returns true once everything is in.
+	bool update(AssetRegistry &assets, float budgetMs = 4);
+	float progress() { return items.empty() ? 1 : (float)added / items.size(); }
+	bool done() { return added == items.size(); }
+
+	float ms = 0;	// from start() until everything was in
+
+private:
+	enum Kind { LoadTexture, LoadAtlas, LoadSound };
+
+	struct Item {
+		Kind kind;
+		string path;
+		int w = 0, h = 0;
+		vector<AtlasImage> images;	// atlas
+		ofPixels pixels;
+		AtlasPage page;
+		atomic<bool> ready { false };
+	};
+
+	void run();
+	void load(Item &item);
+	void join();
+
+	vector<unique_ptr<Item>> items;
+	atomic<int> next { 0 };
+	int added = 0;
+	vector<thread> workers;
+	chrono::steady_clock::time_point begin;
+};
@@ -0,0 +1,152 @@
+#include "AssetRegistry.h"
+
+// Largest atlas texture to try, GL 2.1 hardware and llvmpipe all allow this.
+static const int MAX_ATLAS_SIZE = 2048;
+
+// Images baked at a size are cached separately from the original size.
+string AssetRegistry::key(const string &path, int w, int h) {
+	if (w > 0 && h > 0) { return path + "@" + ofToString(w) + "x" + ofToString(h); }
+	return path;
+}
+
+bool AssetRegistry::load(ofPixels &pixels, const string &path, int w, int h) {
+	if (!ofLoadImage(pixels, path)) {
+		ofLogError("AssetRegistry") << "unable to load " << path;
+		return false;
+	}
+	if (w > 0 && h > 0) { pixels.resize(w, h); }
+	return true;
+}
+
+// Return the texture for an image file, loading it on first request. A width and
+// height can be given to bake the image at that size.
+//
+TextureHandle AssetRegistry::texture(const string &path, int w, int h) {
+	string k = key(path, w, h);
+	auto found = textures.find(k);
+	if (found != textures.end()) { return found->second; }
+
+	// Pixels only live until the texture is uploaded.
+	ofPixels pixels;
+	load(pixels, path, w, h);
+	return addTexture(path, w, h, pixels);
+}
+
+// Upload decoded pixels as the texture for an image file.
+//
+TextureHandle AssetRegistry::addTexture(const string &path, int w, int h, const ofPixels &pixels) {
+	shared_ptr<ofTexture> tex = make_shared<ofTexture>();
+	tex->allocate(pixels);
+	tex->loadData(pixels);
+	TextureHandle region = make_shared<TextureRegion>(tex, ofRectangle(0, 0, pixels.getWidth(), pixels.getHeight()));
+	textures[key(path, w, h)] = region;
+	return region;
+}
+
+// Bake images at their final sizes and pack them into one page, tallest
+// first along shelves. The atlas is the smallest square power of two they
+// fit in. Each image gets a transparent border so filtering never picks up
+// its neighbours. Once addAtlas() uploads the page, texture() calls for
+// these images return their regions of the atlas.
+//
+bool AssetRegistry::pack(const vector<AtlasImage> &images, AtlasPage &page, int padding) {
+	vector<ofPixels> pixels(images.size());
+	vector<int> order;
+	for (int i = 0; i < images.size(); i++) {
+		if (!load(pixels[i], images[i].path, images[i].w, images[i].h)) return false;
+		pixels[i].setImageType(OF_IMAGE_COLOR_ALPHA);
+		order.push_back(i);
+	}
+	sort(order.begin(), order.end(), [&](int a, int b) { return pixels[a].getHeight() > pixels[b].getHeight(); });
+
+	// Shelf packing, growing the atlas until everything fits.
+	vector<ofRectangle> &rects = page.rects;
+	rects.assign(images.size(), ofRectangle());
+	int size = 64;
+	for (;; size *= 2) {
+		if (size > MAX_ATLAS_SIZE) {
+			ofLogError("AssetRegistry") << "atlas images don't fit in " << MAX_ATLAS_SIZE << "px";
+			return false;
+		}
+		int x = 0, y = 0, shelf = 0;
+		bool fits = true;
+		for (int i : order) {
+			int w = pixels[i].getWidth() + 2 * padding;
+			int h = pixels[i].getHeight() + 2 * padding;
+			if (x + w > size) {
+				x = 0;
+				y += shelf;
+				shelf = 0;
+			}
+			if (w > size || y + h > size) {
+				fits = false;
+				break;
+			}
+			rects[i] = ofRectangle(x + padding, y + padding, pixels[i].getWidth(), pixels[i].getHeight());
+			x += w;
+			shelf = max(shelf, h);
+		}
+		if (fits) break;
+	}
+
+	page.images = images;
+	page.pixels.allocate(size, size, OF_IMAGE_COLOR_ALPHA);
+	page.pixels.setColor(ofColor(0, 0, 0, 0));
+	for (int i = 0; i < images.size(); i++) { pixels[i].pasteInto(page.pixels, rects[i].x, rects[i].y); }
+	return true;
+}
+
+// Upload a packed atlas and register its images' regions.
+//
+void AssetRegistry::addAtlas(const AtlasPage &page) {
+	shared_ptr<ofTexture> tex = make_shared<ofTexture>();
+	tex->allocate(page.pixels);
+	tex->loadData(page.pixels);
+	for (int i = 0; i < page.images.size(); i++) {
+		const AtlasImage &image = page.images[i];
+		textures[key(image.path, image.w, image.h)] = make_shared<TextureRegion>(tex, page.rects[i]);
+	}
+	ofLogNotice("AssetRegistry") << "packed " << page.images.size() << " images into a " << page.pixels.getWidth() << "x" << page.pixels.getHeight() << " atlas";
+}
+
+// Return the first player for a sound file, loading it on first request.
+//
+SoundHandle AssetRegistry::sound(const string &path) {
+	auto found = sounds.find(path);
+	if (found != sounds.end() && !found->second.empty()) { return found->second[0]; }
+	return addVoice(path);
+}
+
+// Load another player for a sound file, so one more copy of it can play at
+// once. Each player decodes the file itself.
+//
+SoundHandle AssetRegistry::addVoice(const string &path) {
+	SoundHandle snd = make_shared<ofSoundPlayer>();
+	if (!snd->load(path)) {
+		ofLogError("AssetRegistry") << "unable to load " << path;
+	}
+	sounds[path].push_back(snd);
+	return snd;
+}
+
+// Every player loaded for a sound file, loading one if there are none.
+//
+vector<SoundHandle> AssetRegistry::voices(const string &path) {
+	sound(path);
+	return sounds[path];
+}
+
+// Drop any asset that is no longer referenced outside of the registry.
+//
+void AssetRegistry::purge() {
+	for (auto t = textures.begin(); t != textures.end();) {
+		if (t->second.use_count() == 1) { t = textures.erase(t); }
+		else t++;
+	}
+	for (auto s = sounds.begin(); s != sounds.end();) {
+		bool used = false;
+		for (SoundHandle &v : s->second) { used = used || v.use_count() > 1; }
+		if (!used) { s = sounds.erase(s); }
+		else s++;
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Assets.h"
+
+// An image to pack into an atlas, optionally baked at a given size.
+struct AtlasImage {
+	string path;
+	int w = 0, h = 0;
+};
+
+// Images packed into an atlas on the CPU, ready to upload.
+struct AtlasPage {
+	vector<AtlasImage> images;
+	vector<ofRectangle> rects;	// each image's place in the page
+	ofPixels pixels;
+};
+
+// Asset registry that loads each file in bin/data once and hands out handles.
+// Images are resized to their final size and uploaded to the GPU, after which
+// the CPU side pixels are released. Small images can be packed into one atlas
+// texture with pack() and addAtlas(); asking for them afterwards returns their
+// atlas region. A sound can have several players, one per copy of it that
+// may play at once.
+//
+class AssetRegistry {
+public:
+	TextureHandle texture(const string &path, int w = 0, int h = 0);
+	SoundHandle sound(const string &path);
+	SoundHandle addVoice(const string &path);
+	vector<SoundHandle> voices(const string &path);
+	void purge();
+
+	// Loading in two halves, for AssetLoader. Decoding and packing can run on
+	// any thread, adding the result (uploading textures) only on the main one.
+	static bool load(ofPixels &pixels, const string &path, int w, int h);
+	static bool pack(const vector<AtlasImage> &images, AtlasPage &page, int padding = 2);
+	TextureHandle addTexture(const string &path, int w, int h, const ofPixels &pixels);
+	void addAtlas(const AtlasPage &page);
+	int size() { return textures.size() + sounds.size(); }
+
+	map<string, TextureHandle> textures;
+	map<string, vector<SoundHandle>> sounds;	// each sound's players
+
+private:
+	static string key(const string &path, int w, int h);
+};
@@ -0,0 +1,45 @@
+#include "AudioMixer.h"
+
+// Register a sound's players, one per copy of it that may overlap. Returns
+// the handle to give the game, or an empty one if there are no players.
+//
+SoundHandle AudioMixer::add(const vector<SoundHandle> &voices) {
+	if (voices.empty() || !voices[0]) return SoundHandle();
+	Sound sound;
+	sound.voices = voices;
+	sounds.push_back(sound);
+	return voices[0];
+}
+
+// Mark a sound to play at the next flush. Sounds that were never added are
+// ignored.
+//
+void AudioMixer::queue(const SoundHandle &h) {
+	for (Sound &s : sounds) {
+		if (s.voices[0] != h) continue;
+		if (s.pending) { coalesced++; }
+		s.pending = true;
+		return;
+	}
+}
+
+// Start this frame's sounds, each on the first of its voices that has
+// finished playing, trying them in turn from the one after the last started.
+//
+void AudioMixer::flush() {
+	for (Sound &s : sounds) {
+		if (!s.pending) continue;
+		s.pending = false;
+		int n = s.voices.size();
+		int busy = 0;
+		while (busy < n && s.voices[(s.next + busy) % n]->isPlaying()) { busy++; }
+		if (busy == n) {
+			limited++;
+			continue;
+		}
+		int v = (s.next + busy) % n;
+		s.voices[v]->play();
+		s.next = (v + 1) % n;
+		played++;
+	}
+}
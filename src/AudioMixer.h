@@ -0,0 +1,30 @@
+#pragma once
+
+#include "AssetRegistry.h"
+
+// Plays the game's sounds, on the main thread. Each sound has a player per
+// voice, so as many copies of it can overlap as it has voices; a request
+// while every voice is still playing is dropped. The game only marks which
+// sounds it wants during a frame, so a sound asked for many times in a frame
+// plays once, and flush() starts at most one copy of each sound per frame.
+//
+class AudioMixer {
+public:
+	SoundHandle add(const vector<SoundHandle> &voices);
+
+	void queue(const SoundHandle &s);
+	void queue(const vector<SoundHandle> &s) { for (const SoundHandle &h : s) { queue(h); } }
+	void flush();
+
+	struct Sound {
+		vector<SoundHandle> voices;	// the first is the game's handle
+		int next = 0;			// voice after the one started last
+		bool pending = false;	// asked for since the last flush
+	};
+	vector<Sound> sounds;
+
+	// Stats.
+	int played = 0;
+	int coalesced = 0;	// requests merged into one already pending
+	int limited = 0;	// requests dropped with every voice busy
+};
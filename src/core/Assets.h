@@ -0,0 +1,36 @@
+#pragma once
+
+#include "ofMain.h"
+
+// An image to draw: a rectangle of a GPU texture. An image loaded on its own
+// covers its whole texture, images packed into an atlas share one texture,
+// so they can all be drawn with a single bind.
+//
+struct TextureRegion {
+	TextureRegion(shared_ptr<ofTexture> tex, ofRectangle r) : texture(tex), rect(r) {
+		float tw = tex->getWidth(), th = tex->getHeight();
+		if (tw > 0 && th > 0) {
+			uv[0] = tex->getCoordFromPercent(r.x / tw, r.y / th);
+			uv[1] = tex->getCoordFromPercent((r.x + r.width) / tw, r.y / th);
+			uv[2] = tex->getCoordFromPercent((r.x + r.width) / tw, (r.y + r.height) / th);
+			uv[3] = tex->getCoordFromPercent(r.x / tw, (r.y + r.height) / th);
+		}
+	}
+
+	float getWidth() const { return rect.width; }
+	float getHeight() const { return rect.height; }
+	void draw(float x, float y) const { draw(x, y, rect.width, rect.height); }
+	void draw(float x, float y, float w, float h) const {
+		texture->drawSubsection(x, y, w, h, rect.x, rect.y, rect.width, rect.height);
+	}
+
+	shared_ptr<ofTexture> texture;
+	ofRectangle rect;	// in texture pixels
+	glm::vec2 uv[4];	// corners clockwise from top left, in texture coordinates
+};
+
+// Shared handles to loaded assets. Copying a handle only bumps a reference count.
+// The simulation only stores handles, loading them is up to the host (see
+// AssetRegistry). A headless host leaves them empty.
+typedef shared_ptr<TextureRegion> TextureHandle;
+typedef shared_ptr<ofSoundPlayer> SoundHandle;
@@ -0,0 +1,148 @@
+#include "CollideKernel.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define COLLIDE_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+typedef int(*CollideFn)(float, float, float, const float *, const float *, int, uint32_t *);
+
+static int popcount(uint32_t v) {
+	int c = 0;
+	for (; v; v &= v - 1) c++;
+	return c;
+}
+
+// Reference version, also used for the tail of the SIMD versions.
+//
+static int collideRange(float x, float y, float r2, const float *px, const float *py, int from, int n, uint32_t *mask) {
+	int hits = 0;
+	for (int i = from; i < n; i++) {
+		float dx = px[i] - x;
+		float dy = py[i] - y;
+		if (dx * dx + dy * dy < r2) {
+			mask[i >> 5] |= 1u << (i & 31);
+			hits++;
+		}
+	}
+	return hits;
+}
+
+int collidePointsScalar(float x, float y, float r, const float *px, const float *py, int n, uint32_t *mask) {
+	memset(mask, 0, ((n + 31) / 32) * sizeof(uint32_t));
+	return collideRange(x, y, r * r, px, py, 0, n, mask);
+}
+
+#ifdef COLLIDE_X86
+
+// 4 targets per step. 4 divides 32, so each step's bits land in one mask word.
+//
+int collidePointsSSE(float x, float y, float r, const float *px, const float *py, int n, uint32_t *mask) {
+	memset(mask, 0, ((n + 31) / 32) * sizeof(uint32_t));
+	__m128 qx = _mm_set1_ps(x);
+	__m128 qy = _mm_set1_ps(y);
+	__m128 r2 = _mm_set1_ps(r * r);
+	int hits = 0;
+	int i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 dx = _mm_sub_ps(_mm_loadu_ps(px + i), qx);
+		__m128 dy = _mm_sub_ps(_mm_loadu_ps(py + i), qy);
+		__m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+		uint32_t bits = _mm_movemask_ps(_mm_cmplt_ps(d2, r2));
+		if (bits) {
+			mask[i >> 5] |= bits << (i & 31);
+			hits += popcount(bits);
+		}
+	}
+	return hits + collideRange(x, y, r * r, px, py, i, n, mask);
+}
+
+// 8 targets per step.
+//
+TARGET_AVX2 int collidePointsAVX2(float x, float y, float r, const float *px, const float *py, int n, uint32_t *mask) {
+	memset(mask, 0, ((n + 31) / 32) * sizeof(uint32_t));
+	__m256 qx = _mm256_set1_ps(x);
+	__m256 qy = _mm256_set1_ps(y);
+	__m256 r2 = _mm256_set1_ps(r * r);
+	int hits = 0;
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(px + i), qx);
+		__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(py + i), qy);
+		__m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+		uint32_t bits = _mm256_movemask_ps(_mm256_cmp_ps(d2, r2, _CMP_LT_OQ));
+		if (bits) {
+			mask[i >> 5] |= bits << (i & 31);
+			hits += popcount(bits);
+		}
+	}
+	return hits + collideRange(x, y, r * r, px, py, i, n, mask);
+}
+
+bool cpuHasAVX2() {
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) return false;
+	__cpuid(info, 1);
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#else
+
+int collidePointsSSE(float x, float y, float r, const float *px, const float *py, int n, uint32_t *mask) {
+	return collidePointsScalar(x, y, r, px, py, n, mask);
+}
+
+int collidePointsAVX2(float x, float y, float r, const float *px, const float *py, int n, uint32_t *mask) {
+	return collidePointsScalar(x, y, r, px, py, n, mask);
+}
+
+bool cpuHasAVX2() {
+	return false;
+}
+
+#endif
+
+// Pick the widest kernel once. Function statics are initialized thread safely.
+//
+static CollideFn chooseKernel() {
+#ifdef COLLIDE_X86
+	if (cpuHasAVX2()) return collidePointsAVX2;
+	return collidePointsSSE;
+#else
+	return collidePointsScalar;
+#endif
+}
+
+static CollideFn getKernel() {
+	static CollideFn kernel = chooseKernel();
+	return kernel;
+}
+
+int collidePoints(float x, float y, float r, const float *px, const float *py, int n, uint32_t *mask) {
+	return getKernel()(x, y, r, px, py, n, mask);
+}
+
+const char *collideKernelName() {
+	CollideFn kernel = getKernel();
+	if (kernel == collidePointsAVX2) return "avx2";
+	if (kernel == collidePointsSSE) return "sse";
+	return "scalar";
+}
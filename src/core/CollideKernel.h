@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+// Batch collision kernel testing one point against many packed targets.
+// Bit i of mask (mask[i / 32] >> (i % 32)) is set when target i is within r
+// of (x, y), using squared distances. mask must hold (n + 31) / 32 words.
+// Returns the number of hits.
+//
+// collidePoints picks the widest implementation the CPU supports the first
+// time it is called. The individual versions are exposed for benchmarking,
+// the SIMD ones fall back to scalar when not built for x86.
+//
+int collidePoints(float x, float y, float r, const float *px, const float *py, int n, uint32_t *mask);
+int collidePointsScalar(float x, float y, float r, const float *px, const float *py, int n, uint32_t *mask);
+int collidePointsSSE(float x, float y, float r, const float *px, const float *py, int n, uint32_t *mask);
+int collidePointsAVX2(float x, float y, float r, const float *px, const float *py, int n, uint32_t *mask);
+const char *collideKernelName();
+bool cpuHasAVX2();
+
+// Index of the lowest set bit, v must not be 0.
+inline int lowestBit(uint32_t v) {
+	int b = 0;
+	while (!(v & 1)) { v >>= 1; b++; }
+	return b;
+}
@@ -0,0 +1,85 @@
+#include "CollisionGrid.h"
+
+void CollisionGrid::setup(float width, float height, float size) {
+	cellSize = size;
+	cols = max(1, (int)ceil(width / size));
+	rows = max(1, (int)ceil(height / size));
+	cellStart.assign(cols * rows + 1, 0);
+	clear();
+}
+
+void CollisionGrid::clear() {
+	px.clear();
+	py.clear();
+	lx.clear();
+	ly.clear();
+	cell.clear();
+	maxMove = 0;
+	ids.clear();
+}
+
+int CollisionGrid::cellX(float x) {
+	return ofClamp(floor(x / cellSize), 0, cols - 1);
+}
+
+int CollisionGrid::cellY(float y) {
+	return ofClamp(floor(y / cellSize), 0, rows - 1);
+}
+
+// Add a point and return its id, ids are handed out in order starting at 0.
+// Queries for swept tests should be widened by maxMove.
+//
+int CollisionGrid::add(float x, float y, float lastX, float lastY) {
+	px.push_back(x);
+	py.push_back(y);
+	lx.push_back(lastX);
+	ly.push_back(lastY);
+	maxMove = max(maxMove, (float)sqrt((x - lastX) * (x - lastX) + (y - lastY) * (y - lastY)));
+	cell.push_back(cellY(y) * cols + cellX(x));
+	return px.size() - 1;
+}
+
+// Bin all points by cell. Must be called after adding points and before querying.
+//
+void CollisionGrid::build() {
+	int n = px.size();
+	fill(cellStart.begin(), cellStart.end(), 0);
+	for (int i = 0; i < n; i++) { cellStart[cell[i] + 1]++; }
+	for (int c = 0; c < cols * rows; c++) { cellStart[c + 1] += cellStart[c]; }
+
+	// Scatter ids into place using each cell's start as its write cursor.
+	// This leaves every start pointing at the next cell's start, so shift back.
+	ids.resize(n);
+	for (int i = 0; i < n; i++) { ids[cellStart[cell[i]]++] = i; }
+	sx.resize(n);
+	sy.resize(n);
+	for (int k = 0; k < n; k++) {
+		sx[k] = px[ids[k]];
+		sy[k] = py[ids[k]];
+	}
+	mask.resize((n + 31) / 32);
+	for (int c = cols * rows; c > 0; c--) { cellStart[c] = cellStart[c - 1]; }
+	cellStart[0] = 0;
+}
+
+// Collect the ids of every point within r of (x, y). Only cells overlapping the
+// square around the point are tested. Cells in a row are stored back to back,
+// so each row is a single kernel call.
+//
+void CollisionGrid::query(float x, float y, float r, vector<int> &out) {
+	out.clear();
+	if (px.size() == 0) return;
+	int x0 = cellX(x - r), x1 = cellX(x + r);
+	int y0 = cellY(y - r), y1 = cellY(y + r);
+	for (int cy = y0; cy <= y1; cy++) {
+		int from = cellStart[cy * cols + x0];
+		int to = cellStart[cy * cols + x1 + 1];
+		if (from == to) continue;
+		if (collidePoints(x, y, r, &sx[from], &sy[from], to - from, &mask[0]) == 0) continue;
+		for (int w = 0; w < (to - from + 31) / 32; w++) {
+			for (uint32_t bits = mask[w]; bits; bits &= bits - 1) {
+				out.push_back(ids[from + w * 32 + lowestBit(bits)]);
+			}
+		}
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "ofMain.h"
+#include "CollideKernel.h"
+
+// Swept test for two points moving over the same step. Given the offset between
+// them at the start and at the end of the step, return whether they come within
+// r of each other at any point along the way.
+//
+inline bool sweptHit(float x0, float y0, float x1, float y1, float r) {
+	float dx = x1 - x0;
+	float dy = y1 - y0;
+	float len2 = dx * dx + dy * dy;
+	float t = 0;
+	if (len2 > 0) { t = ofClamp(-(x0 * dx + y0 * dy) / len2, 0, 1); }
+	float cx = x0 + t * dx;
+	float cy = y0 + t * dy;
+	return cx * cx + cy * cy < r * r;
+}
+
+// Uniform grid broad phase over the play field. Points are added each tick and
+// then binned by cell with a counting sort, so a rebuild never allocates once
+// the buffers have grown. Points outside the field fall into the border cells.
+// Each point also keeps where it was at the start of the step for swept tests.
+// Positions are copied into cell order on build, so a query runs the batch
+// collision kernel over one contiguous span per row of cells.
+//
+class CollisionGrid {
+public:
+	void setup(float width, float height, float cellSize);
+	void clear();
+	int add(float x, float y) { return add(x, y, x, y); }
+	int add(float x, float y, float lastX, float lastY);
+	void build();
+	void query(float x, float y, float r, vector<int> &out);
+	float dist2(int id, float x, float y) { return (px[id] - x) * (px[id] - x) + (py[id] - y) * (py[id] - y); }
+	bool sweep(int id, float x0, float y0, float x1, float y1, float r) {
+		return sweptHit(x0 - lx[id], y0 - ly[id], x1 - px[id], y1 - py[id], r);
+	}
+	int size() { return px.size(); }
+
+	vector<float> px, py;	// point positions by id
+	vector<float> lx, ly;	// positions at the start of the step
+	float maxMove = 0;		// furthest any point moved over the step
+
+private:
+	int cellX(float x);
+	int cellY(float y);
+
+	int cols = 1, rows = 1;
+	float cellSize = 1;
+	vector<int> cell;		// cell of each point
+	vector<int> cellStart;	// first entry in ids for each cell, plus one past the end
+	vector<int> ids;		// point ids sorted by cell
+	vector<float> sx, sy;	// positions sorted by cell
+	vector<uint32_t> mask;	// kernel hit bits for one span
+};
@@ -0,0 +1,346 @@
+#include "Emitter.h"
+
+// Modified by Michael Kang for CS134 Project 1.
+
+//
+// Emitter:
+// Create a new Emitter - needs a SpriteSystem.
+//
+Emitter::Emitter(SpriteSystem *spriteSys) {
+	sys = spriteSys;
+	lifespan = 3000;    // Milliseconds.
+	started = false;
+	initial = false;
+
+	lastSpawned = 0;
+	rate = 1;    // Sprites/sec.
+	velocity = glm::vec3(100, 100, 0);
+	haveChildImage = false;
+	haveImage = false;
+	haveSound = false;
+	drawable = true;
+	width = 50;
+	height = 50;
+}
+
+//  Draw the Emitter if it is drawable. In many cases you would want a hidden emitter
+//
+void Emitter::draw(SpriteBatch &batch, float alpha) {
+	if (drawable) {
+		glm::vec3 pos = interpolate ? lerpTrans(alpha) : trans;
+		if (haveImage) {
+			// Images are drawn centered on the emitter.
+			if (hasPower) { batch.add(power, pos.x, pos.y, rot); }
+			batch.add(image, pos.x, pos.y, rot);
+		}
+		else {
+			Profiler::get().count(CountDrawCalls);
+			ofPushMatrix();
+			ofMultMatrix(getMatrix(pos));
+			ofSetColor(0, 0, 200);
+			ofDrawRectangle(-width / 2 + trans.x, -height / 2 + trans.y, width, height);
+			ofPopMatrix();
+		}
+	}
+
+	// Draw sprite system.
+	//
+	sys->draw(batch, alpha);
+}
+
+//  Update the Emitter. If it has been started, spawn new sprites with
+//  initial velocity, lifespan, birthtime.
+//
+void Emitter::update(Tick now) {
+	emitted = false;
+
+	// Check if started, if not, check if there are any sprites still on screen,
+	// and run update on them until they are removed.
+	if (!started) {
+		if (sys->size() > 0) { sys->update(now); }
+		return;
+	}
+
+	// Enemies fire when their fleet's fire queue says so.
+	if (!isEnemy && (!initial || (now - lastSpawned) > (TICK_RATE / rate))) {
+		fire(now);
+		// Sound is played by the owner (placed here to ensure sound plays during spacebar hold).
+		emitted = true;
+	}
+
+	sys->update(now);
+}
+
+// Spawn a new sprite.
+void Emitter::fire(Tick now) {
+	sys->spawn(trans, velocity, lifespan, now);
+	lastSpawned = now;
+	initial = true;
+}
+
+// Determine hit radius based on velocity, the distance covered in one frame
+// at the tuned frame rate.
+float Emitter::hitRadius() {
+	return velocity.length() / TUNED_FRAMERATE;
+}
+
+float Emitter::age(Tick now) {
+	return (now - birth) * TICK_DT;
+}
+
+// Start/Stop the emitter.
+//
+void Emitter::start(Tick now) {
+	started = true;
+	lastSpawned = now;
+	if (sys) { sys->position = trans; }
+}
+
+void Emitter::stop() {
+	started = false;
+	initial = false;
+}
+
+void Emitter::setLifespan(float life) {
+	lifespan = life;
+}
+
+void Emitter::setVelocity(ofVec3f v) {
+	velocity = v;
+}
+
+// Setting an empty handle (as a headless host does) leaves the emitter
+// drawing placeholders and playing nothing.
+//
+void Emitter::setChildImage(TextureHandle img) {
+	childImage = img;
+	haveChildImage = (img != NULL);
+	sys->setImage(childImage);
+}
+
+void Emitter::setImage(TextureHandle img) {
+	image = img;
+	haveImage = (img != NULL);
+}
+
+void Emitter::setRate(float r) {
+	rate = r;
+}
+
+void Emitter::setSound(SoundHandle s) {
+	soundEffect = s;
+	haveSound = (s != NULL);
+}
+
+//
+// Emitter Pool:
+// All slots and their sprite systems are allocated up front.
+//
+EmitterPool::EmitterPool(int capacity) {
+	slots.resize(capacity);
+	systems.resize(capacity);
+	generation.resize(capacity, 0);
+	liveIndex.resize(capacity, -1);
+	live.reserve(capacity);
+	freeSlots.reserve(capacity);
+	for (int i = capacity - 1; i >= 0; i--) { freeSlots.push_back(i); }
+}
+
+// Copy an emitter into a free slot and give it that slot's sprite system.
+// Returns an invalid handle if the pool is full.
+//
+EmitterHandle EmitterPool::add(const Emitter &e) {
+	EmitterHandle h;
+	if (freeSlots.empty()) {
+		dropped++;
+		return h;
+	}
+	int slot = freeSlots.back();
+	freeSlots.pop_back();
+
+	slots[slot] = e;
+	systems[slot].clear();
+	systems[slot].setImage(e.childImage);
+	slots[slot].sys = &systems[slot];
+
+	liveIndex[slot] = live.size();
+	live.push_back(slot);
+	if (live.size() > highWater) { highWater = live.size(); }
+
+	h.index = slot;
+	h.generation = generation[slot];
+	return h;
+}
+
+// Remove the i-th live emitter. The last live emitter takes its place in the
+// dense list, so loops removing while iterating should not advance i.
+//
+void EmitterPool::removeAt(int i) {
+	int slot = live[i];
+	int last = live.back();
+	live[i] = last;
+	liveIndex[last] = i;
+	live.pop_back();
+
+	liveIndex[slot] = -1;
+	generation[slot]++;
+	slots[slot].image = NULL;
+	slots[slot].childImage = NULL;
+	slots[slot].power = NULL;
+	slots[slot].soundEffect = NULL;
+	freeSlots.push_back(slot);
+}
+
+void EmitterPool::remove(EmitterHandle h) {
+	if (get(h) != NULL) { removeAt(liveIndex[h.index]); }
+}
+
+Emitter *EmitterPool::get(EmitterHandle h) {
+	if (h.index < 0 || h.index >= slots.size()) return NULL;
+	if (generation[h.index] != h.generation || liveIndex[h.index] == -1) return NULL;
+	return &slots[h.index];
+}
+
+EmitterHandle EmitterPool::handle(int i) {
+	EmitterHandle h;
+	h.index = live[i];
+	h.generation = generation[h.index];
+	return h;
+}
+
+//
+// Mama Emitter:
+// Constructor for mother of emitters. Each fleet copies the ship it emits,
+// so fleets sharing a template never see each other's changes to it. Ships
+// get their sprite systems from the pool.
+MamaEmitter::MamaEmitter(Emitter *e, int capacity) : emitter(*e), emitters(capacity) {
+	emitter.sys = NULL;
+	fireQueue.reserve(capacity);
+}
+
+// Launch a ship of this kind on a path, copying the fleet's ship. The pool
+// provides its SpriteSystem, its first shot is scheduled from this fleet's
+// stream and its end goes on the expiry wheel.
+void MamaEmitter::spawn(Tick now, int path, const ShipArchetype &a) {
+	emitter.birth = now;
+	emitter.duration = a.life * 1000;
+	emitter.pathSpeed = a.speed;
+	emitter.rate = a.fire;
+	emitter.aimed = a.aimed;
+	emitter.velocity = ofVec3f(0, speed, 0);
+	emitter.rot = a.aimed ? 0 : 180;
+
+	// If the emitter hasn't started, start it.
+	if (!emitter.started) { emitter.start(now); }
+
+	emitter.path = path;
+	emitter.setPosition(pathPoint(emitter, 0));
+	EmitterHandle h = emitters.add(emitter);
+	schedule(h, now);
+	if (emitters.get(h)) { expiry.schedule(now + (Tick)ceil(a.life * TICK_RATE), h); }
+}
+
+// Queue a ship's next shot, a random wait in ticks after from with rate
+// shots/sec on average. Ships that don't fire, or didn't fit in the pool,
+// are left out.
+void MamaEmitter::schedule(EmitterHandle h, double from) {
+	Emitter *e = emitters.get(h);
+	if (e == NULL || e->rate <= 0) return;
+	ScheduledShot shot;
+	shot.tick = from + random.exponential(TICK_RATE / e->rate);
+	shot.ship = h;
+	fireQueue.push_back(shot);
+	push_heap(fireQueue.begin(), fireQueue.end(), greater<ScheduledShot>());
+}
+
+// Fire every shot that has come due. A shot whose ship has since been hit or
+// returned to the pool is dropped, along with the rest of that ship's shots.
+void MamaEmitter::fire(Tick now) {
+	while (!fireQueue.empty() && fireQueue.front().tick <= now) {
+		pop_heap(fireQueue.begin(), fireQueue.end(), greater<ScheduledShot>());
+		ScheduledShot shot = fireQueue.back();
+		fireQueue.pop_back();
+		Emitter *e = emitters.get(shot.ship);
+		if (e == NULL || !e->started) continue;
+		e->fire(now);
+		schedule(shot.ship, shot.tick);
+	}
+}
+
+//  Update the Emitter, moving and aiming the ships it has launched.
+//
+void MamaEmitter::update(Tick now) {
+	// Check if started, if not, check if there are any emitters still on screen,
+	// and run update on them until they are removed.
+	if (!started) {
+		if (emitters.size() > 0) { move(now); }
+		return;
+	}
+
+	// Check to see if any emitter emitted has been hit (its drawable set to false)
+	// If so, check if it has any shots fired, once all of its projectiles are finished,
+	// remove the emitter from list.
+	for (int i = 0; i < emitters.size();) {
+		if (emitters[i].drawable == false && emitters[i].sys->size() == 0) { emitters.removeAt(i); }
+		else i++;
+	}
+
+	// Fire what's due, then update emitter movement and rotation.
+	fire(now);
+	move(now);
+	rotation();
+}
+
+// Move the emitters based on path selection.
+void MamaEmitter::move(Tick now) {
+	// Return the ships whose lifespan is up to the pool. Ships already gone
+	// leave stale handles, which remove() ignores. The wheel keeps up even
+	// with no ships, so it never has a backlog of ticks to walk.
+	//
+	expiry.advance(now, [this](EmitterHandle h) { emitters.remove(h); });
+	if (emitters.size() == 0) return;
+
+	//  Move sprite.
+	//  TODO: Move function to each object, so each object will have its own move function that can be
+	//  changed and set seperately.
+	//  Ships are where the distance flown since they spawned puts them.
+	for (int i = 0; i < emitters.size(); i++) {
+		Emitter &e = emitters[i];
+		e.update(now);
+		e.prevTrans = e.trans;
+		e.trans = pathPoint(e, e.age(now) * e.pathSpeed);
+	}
+}
+
+// Position of an emitter s pixels along its path.
+ofVec3f MamaEmitter::pathPoint(const Emitter &e, float s) {
+	if (e.path < 0 || library == NULL) { return ofVec3f(trans.x, trans.y + s, 0); }
+	glm::vec2 p = library->get(e.path).at(s);
+	return ofVec3f(trans.x + (type ? p.x : -p.x), trans.y + p.y, 0);
+}
+
+// Rotate emitters based on player position.
+// Ships that shoot straight down keep facing down.
+void MamaEmitter::rotation() {
+	for (int i = 0; i < emitters.size(); i++) {
+		if (!emitters[i].aimed) continue;
+		// Adjust rotation of emitter for draw().
+		emitters[i].rot = glm::degrees(glm::orientedAngle(glm::vec3(0, -1, 0), glm::normalize(target - emitters[i].trans), glm::vec3(0, 0, 1)));
+		// Adjust vector for emitter's sprite velocity.
+		emitters[i].setVelocity(glm::normalize(target - emitters[i].trans) * speed);
+	}
+}
+
+// Hide the i-th emitter and stop emitting projectiles. It is returned to the
+// pool once its remaining projectiles are gone.
+void MamaEmitter::hit(int i) {
+	emitters[i].drawable = false;
+	emitters[i].stop();
+}
+
+// Draw emitters with modified rotation/translations.
+void MamaEmitter::draw(SpriteBatch &batch, float alpha) {
+	for (int i = 0; i < emitters.size(); i++) {
+		emitters[i].draw(batch, alpha);
+	}
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "ofMain.h"
+#include "Assets.h"
+#include "Level.h"
+#include "Paths.h"
+#include "Random.h"
+#include "Sprite.h"
+#include "TimingWheel.h"
+
+// Modified by Michael Kang for CS134 Project 1.
+
+// General purpose Emitter class for emitting sprites.
+//
+class Emitter : public BaseObject {
+public:
+	Emitter(SpriteSystem *);
+	Emitter() : Emitter(NULL) {}	// no sprites of its own (MamaEmitter)
+
+	void draw(SpriteBatch &batch, float alpha = 1);
+	void start(Tick now);
+	void stop();
+	void setLifespan(float);
+	void setVelocity(ofVec3f);
+	void setChildImage(TextureHandle);
+	void setImage(TextureHandle);
+	void setSound(SoundHandle);
+	void setRate(float);
+	void update(Tick now);
+	void fire(Tick now);
+	float hitRadius();
+	float age(Tick now);	// sec
+
+	SpriteSystem *sys;
+	ofVec3f velocity;
+	float rate;
+	float lifespan;
+	Tick lastSpawned;
+	float width, height;
+	Tick birth;
+	float duration;
+	int path = -1;			// id in the fleet's path library, -1 flies straight
+	float pathSpeed = 100;	// px/s along the path
+	Tick powertime;
+
+	TextureHandle childImage;
+	TextureHandle image;
+	TextureHandle power;
+	SoundHandle soundEffect;
+
+	bool initial;
+	bool started;
+	bool drawable;
+	bool haveChildImage;
+	bool haveImage;
+	bool haveSound;
+	bool emitted = false;	// spawned a sprite on the last update, the owner plays the sound
+	bool isEnemy = false;
+	bool hasPower = false;
+	bool interpolate = true;	// draw between ticks, off for directly controlled objects
+	bool aimed = true;			// enemy ships turn their shots on the player
+};
+
+// Handle to an emitter in an EmitterPool. The slot's generation is bumped each
+// time it is freed, so a handle to a recycled slot no longer resolves.
+//
+struct EmitterHandle {
+	int index = -1;
+	unsigned generation = 0;
+};
+
+// Fixed capacity pool that owns child emitters and their sprite systems.
+// Live emitters are kept in a dense list for iteration, freed slots go on a
+// free list so allocation and removal are both O(1).
+//
+class EmitterPool {
+public:
+	EmitterPool(int capacity = 64);
+
+	EmitterHandle add(const Emitter &);
+	void remove(EmitterHandle);
+	void removeAt(int i);
+	Emitter *get(EmitterHandle);
+	EmitterHandle handle(int i);
+
+	// Iterate live emitters by dense index.
+	Emitter &operator[](int i) { return slots[live[i]]; }
+	int size() { return live.size(); }
+
+	// Stats for sizing the pool.
+	int capacity() { return slots.size(); }
+	float occupancy() { return (float)live.size() / slots.size(); }
+	int highWater = 0;	// most emitters live at once
+	int dropped = 0;	// spawns refused because the pool was full
+
+	vector<Emitter> slots;
+	vector<SpriteSystem> systems;	// projectile storage for each slot
+	vector<unsigned> generation;
+	vector<int> freeSlots;
+	vector<int> live;			// dense list of live slot indices
+	vector<int> liveIndex;		// slot -> position in live, -1 if free
+};
+
+// A ship's next shot, kept in its fleet's fire queue. The fraction of a tick
+// is kept so the waits between shots add up exactly.
+struct ScheduledShot {
+	double tick;
+	EmitterHandle ship;
+	bool operator>(const ScheduledShot &o) const { return tick > o.tick || (tick == o.tick && ship.index > o.ship.index); }
+};
+
+// Essentially an emitter emitting emitters AKA MamaEmitter.
+// Derived from Emitter, with some modified functions and extra ones to control
+// rotation and movement. Ships are launched by the level's spawner, each on
+// its own path and archetype. Enemy ships fire as a Poisson process: each
+// shot is scheduled when the one before it is fired, and the fleet only
+// visits the ships that are due.
+class MamaEmitter : public Emitter {
+public:
+	MamaEmitter(Emitter *, int capacity = 64);
+
+	void spawn(Tick now, int path, const ShipArchetype &a);
+	void update(Tick now);
+	void move(Tick now);
+	void fire(Tick now);
+	void schedule(EmitterHandle h, double from);
+	void draw(SpriteBatch &batch, float alpha = 1);
+	void rotation();
+	void hit(int i);
+	ofVec3f pathPoint(const Emitter &e, float s);
+
+	Emitter emitter;		// this fleet's own copy of the ship it emits
+	EmitterPool emitters;
+	Random random;		// this fleet's stream, also used by its ships to fire
+	vector<ScheduledShot> fireQueue;	// min-heap on tick, stale handles dropped when popped
+	TimingWheel<EmitterHandle> expiry;	// ships by the tick their lifespan ends
+
+	// Data:
+	glm::vec3 target;
+	const PathLibrary *library = NULL;	// must outlive the fleet
+
+	float speed = 100;	// Speed of emitted emitters' shots.
+	float shipRadius = 100 / TUNED_FRAMERATE;	// ships' hit radius against the player, px
+	bool type = true;	// false flies the paths mirrored
+};
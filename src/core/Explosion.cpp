@@ -0,0 +1,187 @@
+#include "Explosion.h"
+
+// Modified by Michael Kang for CS134.
+
+// Debris class definitions.
+Debris::Debris() {
+
+	// Initialize particle with some reasonable values first.
+	//
+	velocity.set(0, 0, 0);
+	acceleration.set(0, 0, 0);
+	position.set(0, 0, 0);
+	prevPosition.set(0, 0, 0);
+	forces.set(0, 0, 0);
+	lifespan = 5;
+	birthtime = 0;
+	radius = .1;
+	damping = .99;
+	mass = 1;
+}
+
+// Physics based movement for explosion particles.
+void Debris::integrate() {
+	// Interval for this step.
+	float dt = TICK_DT;
+
+	// Update position based on velocity.
+	prevPosition = position;
+	position += (velocity * dt);
+
+	// Update acceleration with accumulated particles forces.
+	ofVec3f accel = acceleration; 
+	accel += (forces * (1.0 / mass));
+	velocity += accel * dt;
+
+	// Add a little damping for good measure.
+	velocity *= damping;
+
+	// Clear forces on particle (they get re-added each step).
+	forces.set(0, 0, 0);
+}
+
+// Fade out and spin a quarter turn per tick, both worked out from age so
+// they run at the same speed whatever the frame rate.
+void Debris::fade(Tick now) {
+	alpha = max(0.0f, 255 - DEBRIS_FADE * age(now));
+	quarterTurns = (now - birthtime) % 4;
+}
+
+//  Return age in seconds.
+float Debris::age(Tick now) {
+	return (now - birthtime) * TICK_DT;
+}
+
+// Explosion pool definitions. The shared forces are a pull of zero gravity
+// and a one shot radial kick.
+ExplosionPool::ExplosionPool(int bursts, int debris) {
+	maxBursts = bursts;
+	maxDebris = debris;
+	this->bursts.reserve(maxBursts);
+	this->debris.reserve(maxDebris);
+	forces.get<RadialImpulse>().magnitude = 2000.0;
+}
+
+// Set off an explosion at a point.
+bool ExplosionPool::start(const ofVec3f &pos, Tick now) {
+	if (bursts.size() == maxBursts) {
+		dropped += groupSize;
+		return false;
+	}
+	bursts.push_back({ pos, now, false });
+	return true;
+}
+
+void ExplosionPool::clear() {
+	bursts.clear();
+	debris.clear();
+}
+
+// Move the debris already out, dropping finished explosions and expired
+// debris first.
+void ExplosionPool::update(Tick now) {
+	// Keep the rest in order.
+	int live = 0;
+	for (int i = 0; i < bursts.size(); i++) {
+		if (bursts[i].fired && (now - bursts[i].birthtime) * TICK_DT > lifespan) continue;
+		bursts[live++] = bursts[i];
+	}
+	bursts.resize(live);
+	live = 0;
+	for (int i = 0; i < debris.size(); i++) {
+		if (debris[i].lifespan != -1 && debris[i].age(now) > debris[i].lifespan) continue;
+		debris[live++] = debris[i];
+	}
+	debris.resize(live);
+	move(0, now);
+}
+
+// Spawn debris for explosions started since the last spawn, and give it its
+// first step.
+void ExplosionPool::spawn(Tick now) {
+	int spawned = debris.size();
+	for (Burst &b : bursts) {
+		if (b.fired) continue;
+		for (int i = 0; i < groupSize; i++) {
+			if (debris.size() == maxDebris) {
+				dropped++;
+				continue;
+			}
+			Debris particle;
+			ofVec3f dir = ofVec3f(rng->range(-1, 1), rng->range(-1, 1), 0);
+			particle.velocity = dir.getNormalized() * speed;
+			particle.position.set(b.position);
+			particle.prevPosition.set(b.position);
+			particle.lifespan = lifespan;
+			particle.birthtime = now;
+			particle.radius = particleRadius;
+			debris.push_back(particle);
+		}
+		b.fired = true;
+	}
+	kick(spawned);
+	move(spawned, now);
+}
+
+// One pass over the debris from first on: forces, then integrate.
+void ExplosionPool::move(int first, Tick now) {
+	for (int i = first; i < debris.size(); i++) {
+		Debris &d = debris[i];
+		forces.apply(d);
+		for (ParticleForce *f : custom) {
+			if (!f->applyOnce) f->updateForce(&d);
+		}
+		d.integrate();
+		d.fade(now);
+	}
+}
+
+// Apply one shot forces to the debris from first on, once they're spawned.
+void ExplosionPool::kick(int first) {
+	for (int i = first; i < debris.size(); i++) {
+		forces.kick(debris[i]);
+		for (ParticleForce *f : custom) {
+			if (f->applyOnce) f->updateForce(&debris[i]);
+		}
+	}
+}
+
+//  Draw the particle cloud between the last two ticks, alpha is how far
+//  into the current one.
+//
+void ExplosionPool::draw(SpriteBatch &batch, float alpha) {
+	if (image == NULL) return;
+	float w = image->getWidth();
+	float h = image->getHeight();
+	for (const Debris &d : debris) {
+		// The spin rotates the quad, the one shared texture is untouched.
+		ofVec3f pos = d.prevPosition + (d.position - d.prevPosition) * alpha;
+		batch.add(image, pos.x, pos.y, w, h, 90 * d.quarterTurns, d.alpha);
+	}
+}
+
+// Gravity Force Field 
+//
+GravityForce::GravityForce(const ofVec3f &g) {
+	gravity = g;
+}
+
+void GravityForce::updateForce(Debris * particle) {
+	//
+	// f = mg
+	//
+	particle->forces += gravity * particle->mass;
+}
+
+// Impulse Radial Force - this is a "one shot" force that
+// eminates radially outward in random directions.
+ImpulseRadialForce::ImpulseRadialForce(float magnitude) {
+	this->magnitude = magnitude;
+	this->height = 1;
+	applyOnce = true;
+}
+
+void ImpulseRadialForce::updateForce(Debris *particle) {
+	ofVec3f dir = ofVec3f(rng->range(-1, 1), rng->range(-1, 1), 0);
+	particle->forces += dir.getNormalized() * magnitude;
+}
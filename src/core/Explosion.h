@@ -0,0 +1,158 @@
+#pragma once
+
+// Modified by Michael Kang for CS134.
+
+#include "ofMain.h"
+#include <tuple>
+#include "Assets.h"
+#include "GameClock.h"
+#include "Profiler.h"
+#include "Random.h"
+#include "SpriteBatch.h"
+
+// Debris alpha lost per second, it started out as 5 a frame at 60 fps.
+const float DEBRIS_FADE = 300;
+
+// Particle class used for explosions.
+class Debris {
+public:
+	Debris();
+
+	ofVec3f position;
+	ofVec3f prevPosition;	// position before the last tick
+	ofVec3f velocity;
+	ofVec3f acceleration;
+	ofVec3f forces;
+	float damping;
+	float mass;
+	float lifespan;
+	float radius;
+	Tick birthtime;
+	float alpha = 255;		// set from age each update
+	int quarterTurns = 0;	// spin, also set from age
+	void integrate();
+	void fade(Tick now);
+	float age(Tick now);        // sec
+};
+
+//  Pure Virtual Function Class - must be subclassed to create new forces.
+//  This is the slow path, for forces added to a pool at run time. One shot
+//  forces are applied to each particle once, when it is spawned.
+//
+class ParticleForce {
+protected:
+public:
+	bool applyOnce = false;
+	virtual void updateForce(Debris *) = 0;
+};
+
+// Some convenient built-in forces
+//
+class GravityForce : public ParticleForce {
+	ofVec3f gravity;
+public:
+	GravityForce(const ofVec3f & gravity);
+	void set(const ofVec3f & g) { gravity = g; }
+	void updateForce(Debris *);
+};
+
+class ImpulseRadialForce : public ParticleForce {
+	float magnitude, height;
+public:
+	ImpulseRadialForce(float magnitude);
+	void set(float mag) { magnitude = mag; }
+	void setHeight(float h) { height = h; }
+	void updateForce(Debris *);
+
+	Random *rng = NULL;
+};
+
+// Built-in forces for a ForceSet. kick() is a one shot impulse, applied once
+// when a particle is spawned, apply() runs every update. Neither is virtual,
+// so a ForceSet's calls inline into the pool's update loop.
+//
+struct Gravity {
+	ofVec3f gravity = ofVec3f(0, 0, 0);
+
+	void kick(Debris &) {}
+	void apply(Debris &d) { d.forces += gravity * d.mass; }	// f = mg
+};
+
+// Pushes each particle out in a random direction.
+struct RadialImpulse {
+	float magnitude = 0;
+	Random *rng = NULL;
+
+	void kick(Debris &d) {
+		ofVec3f dir = ofVec3f(rng->range(-1, 1), rng->range(-1, 1), 0);
+		d.forces += dir.getNormalized() * magnitude;
+	}
+	void apply(Debris &) {}
+};
+
+// A fixed set of forces, applied in the order listed. Each force is reached
+// by type, e.g. forces.get<Gravity>().
+//
+template <class... Forces>
+class ForceSet {
+public:
+	template <class F> F &get() { return std::get<F>(forces); }
+
+	void kick(Debris &d) {
+		int each[] = { 0, (std::get<Forces>(forces).kick(d), 0)... };
+		(void)each;
+	}
+	void apply(Debris &d) {
+		int each[] = { 0, (std::get<Forces>(forces).apply(d), 0)... };
+		(void)each;
+	}
+
+private:
+	std::tuple<Forces...> forces;
+};
+
+// The forces on every explosion's debris.
+typedef ForceSet<Gravity, RadialImpulse> DebrisForces;
+
+// Preallocated explosions. Every explosion shares the same forces, and all
+// debris lives in one buffer kept in spawn order. Starting an explosion only
+// records where and when, its debris comes out on the next spawn(). Nothing
+// is allocated once the pool is built; past capacity, bursts and debris are
+// dropped and counted.
+//
+class ExplosionPool {
+public:
+	ExplosionPool(int maxBursts = 128, int maxDebris = 2048);
+
+	bool start(const ofVec3f &pos, Tick now);
+	void update(Tick now);
+	void spawn(Tick now);
+	void move(int first, Tick now);
+	void draw(SpriteBatch &batch, float alpha = 1);
+	void clear();
+	void setImage(TextureHandle img) { image = img; }
+	void setRandom(Random *r) { rng = r; forces.get<RadialImpulse>().rng = r; }
+	void kick(int first);
+	int size() { return bursts.size(); }	// live explosions
+
+	// An explosion: where it went off, and whether its debris is out yet.
+	struct Burst {
+		ofVec3f position;
+		Tick birthtime;
+		bool fired;
+	};
+
+	vector<Burst> bursts;
+	vector<Debris> debris;
+	DebrisForces forces;
+	vector<ParticleForce *> custom;	// applied after forces, not owned
+
+	Random *rng = NULL;		// debris directions
+	TextureHandle image;	// shared by all debris
+	float lifespan = 1;		// sec
+	float speed = 0;		// initial debris speed
+	float particleRadius = 1;
+	int groupSize = 10;		// particles per explosion
+	int maxBursts, maxDebris;
+	int dropped = 0;		// debris not spawned because the pool was full
+};
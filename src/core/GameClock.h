@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+// Fixed simulation step. Game logic always advances by TICK_DT seconds and
+// ofApp::update runs as many ticks as the elapsed real time calls for.
+const int TICK_RATE = 60;
+const float TICK_DT = 1.0f / TICK_RATE;
+
+// Most ticks run in one frame. Time beyond this after a hitch is dropped so a
+// long stall can't snowball into an even longer catch up.
+const int MAX_TICKS_PER_FRAME = 5;
+
+// Game time counted in whole ticks. Times kept as ticks stay exact however
+// long a game runs.
+typedef uint64_t Tick;
+
+// Expiry tick of something that never expires.
+const Tick TICK_NEVER = ~(Tick)0;
+
+// Whole ticks in a duration given in ms, to the nearest tick.
+inline Tick ticksFor(float ms) { return (Tick)llround(ms * TICK_RATE / 1000.0); }
+
+// Time source for the simulation, supplied by its host. Everything in the
+// core reads time from here instead of ofGetElapsedTimeMillis(). Ticks are
+// counted from when the current game started.
+//
+class Clock {
+public:
+	virtual ~Clock() {}
+	virtual Tick tick() = 0;		// current time in ticks
+	virtual void advance() {}		// called once at the end of every tick
+	virtual void restart() {}		// called when a game starts
+};
+
+// Clock that only moves when the simulation ticks, so game time is the same
+// no matter how fast the ticks actually run.
+//
+class TickClock : public Clock {
+public:
+	Tick tick() { return ticks - epoch; }
+	void advance() { ticks++; }
+	void restart() { epoch = ticks; }
+
+	uint64_t ticks = 0;		// since the clock was made
+	uint64_t epoch = 0;		// ticks when the current game started
+};
@@ -0,0 +1,162 @@
+#include "JobSystem.h"
+
+#include <chrono>
+
+// The system and queue of the thread running a job, if it is one of ours.
+static thread_local JobSystem *workerSystem = NULL;
+static thread_local int workerIndex = 0;
+
+JobSystem::JobSystem() {
+	queues.push_back(unique_ptr<Queue>(new Queue()));
+	queues[0]->jobs.reserve(256);
+}
+
+void JobSystem::setup(int threads) {
+	stop();
+	quit = false;
+	queues.resize(1);
+	for (int i = 1; i <= threads; i++) {
+		queues.push_back(unique_ptr<Queue>(new Queue()));
+		queues[i]->jobs.reserve(256);
+	}
+	for (int i = 1; i <= threads; i++) { workers.push_back(thread(&JobSystem::work, this, i)); }
+}
+
+void JobSystem::stop() {
+	{
+		lock_guard<mutex> l(sleepLock);
+		quit = true;
+	}
+	wake.notify_all();
+	for (thread &t : workers) { t.join(); }
+	workers.clear();
+}
+
+int JobSystem::current() {
+	return workerSystem == this ? workerIndex : 0;
+}
+
+// Queue a job on the calling thread's queue and wake a sleeping worker.
+void JobSystem::push(const Job &job) {
+	Queue &q = *queues[current()];
+	{
+		lock_guard<mutex> l(q.lock);
+		q.jobs.push_back(job);
+	}
+	queued++;
+	if (!workers.empty()) {
+		{ lock_guard<mutex> l(sleepLock); }
+		wake.notify_one();
+	}
+}
+
+bool JobSystem::pop(int index, Job &job) {
+	Queue &q = *queues[index];
+	lock_guard<mutex> l(q.lock);
+	if (q.head == q.jobs.size()) return false;
+	job = q.jobs.back();
+	q.jobs.pop_back();
+	if (q.head == q.jobs.size()) {
+		q.jobs.clear();
+		q.head = 0;
+	}
+	return true;
+}
+
+// Take the oldest job from the first other queue that has one.
+bool JobSystem::steal(int index, Job &job) {
+	for (int i = 1; i < queues.size(); i++) {
+		Queue &q = *queues[(index + i) % queues.size()];
+		lock_guard<mutex> l(q.lock);
+		if (q.head == q.jobs.size()) continue;
+		job = q.jobs[q.head++];
+		if (q.head == q.jobs.size()) {
+			q.jobs.clear();
+			q.head = 0;
+		}
+		return true;
+	}
+	return false;
+}
+
+bool JobSystem::runOne(int index) {
+	Job job;
+	if (!pop(index, job) && !steal(index, job)) return false;
+	queued--;
+	job.run(job.data, job.index);
+	if (job.counter) { job.counter->left--; }
+	return true;
+}
+
+void JobSystem::work(int index) {
+	workerSystem = this;
+	workerIndex = index;
+	while (true) {
+		if (runOne(index)) continue;
+		unique_lock<mutex> l(sleepLock);
+		wake.wait(l, [this] { return quit || queued > 0; });
+		if (quit) return;
+	}
+}
+
+// Help out until the group is done. The last few jobs may be running on
+// other threads with nothing left to take, so this spins briefly.
+void JobSystem::wait(JobCounter &counter) {
+	int index = current();
+	while (counter.left > 0) {
+		if (!runOne(index)) { this_thread::yield(); }
+	}
+}
+
+static void runIndex(void *f, int i) {
+	(*(const function<void(int)> *)f)(i);
+}
+
+// Call f(0) .. f(n - 1), each once, spread over the threads, and wait for
+// them all.
+void JobSystem::parallelFor(int n, const function<void(int)> &f) {
+	if (workers.empty() || n < 2) {
+		for (int i = 0; i < n; i++) { f(i); }
+		return;
+	}
+	JobCounter counter;
+	counter.left = n;
+	for (int i = 0; i < n; i++) { push({ runIndex, (void *)&f, i, &counter }); }
+	wait(counter);
+}
+
+//
+// Task graph:
+// Returns the new task's index, for later tasks to wait on.
+int TaskGraph::add(const string &name, const function<void()> &f, const vector<int> &after) {
+	Task *t = new Task();
+	t->name = name;
+	t->f = f;
+	t->deps = after.size();
+	for (int i : after) { tasks[i]->next.push_back(tasks.size()); }
+	tasks.push_back(unique_ptr<Task>(t));
+	return tasks.size() - 1;
+}
+
+// Queue the tasks that wait on nothing, then help until every task is done.
+void TaskGraph::run(JobSystem &j) {
+	jobs = &j;
+	done.left = tasks.size();
+	for (unique_ptr<Task> &t : tasks) { t->waiting = t->deps; }
+	for (int i = 0; i < tasks.size(); i++) {
+		if (tasks[i]->deps == 0) { jobs->push({ runTask, this, i, &done }); }
+	}
+	jobs->wait(done);
+}
+
+// Run a task, then queue whatever was only waiting on it.
+void TaskGraph::runTask(void *graph, int index) {
+	TaskGraph *g = (TaskGraph *)graph;
+	Task &t = *g->tasks[index];
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+	t.f();
+	t.ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+	for (int n : t.next) {
+		if (--g->tasks[n]->waiting == 0) { g->jobs->push({ runTask, graph, n, &g->done }); }
+	}
+}
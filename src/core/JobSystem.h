@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Counts the jobs of a group still to finish, for JobSystem::wait.
+struct JobCounter {
+	atomic<int> left { 0 };
+};
+
+// A job is a function pointer with an argument, so queueing one never
+// allocates.
+struct Job {
+	void (*run)(void *data, int index);
+	void *data;
+	int index;
+	JobCounter *counter;
+};
+
+// Small work stealing job system. Each worker thread has its own queue: it
+// runs its newest job first, and when it runs dry it steals the oldest job
+// from another queue. Queue 0 belongs to the thread driving the system
+// (the game thread), which runs jobs too while it waits. Only that one
+// thread may push from outside a job.
+//
+class JobSystem {
+public:
+	JobSystem();
+	~JobSystem() { stop(); }
+
+	void setup(int threads);	// extra threads, 0 runs every job on the caller
+	int threads() { return workers.size(); }
+
+	void push(const Job &job);
+	void wait(JobCounter &counter);		// runs jobs until counter reaches 0
+	void parallelFor(int n, const function<void(int)> &f);
+
+private:
+	// Owner pops from the back, thieves take from the front.
+	struct Queue {
+		mutex lock;
+		vector<Job> jobs;
+		int head = 0;
+	};
+
+	void stop();
+	void work(int index);
+	bool runOne(int index);
+	bool pop(int index, Job &job);
+	bool steal(int index, Job &job);
+	int current();
+
+	vector<thread> workers;
+	vector<unique_ptr<Queue>> queues;	// one per worker, plus the caller's
+	atomic<int> queued { 0 };			// jobs waiting in any queue
+	mutex sleepLock;
+	condition_variable wake;
+	bool quit = false;
+};
+
+// A fixed set of named tasks and the tasks each must wait for, run on a
+// JobSystem. A task is queued as soon as everything it waits for is done,
+// so tasks that don't depend on each other can run at the same time. Each
+// run times every task.
+//
+class TaskGraph {
+public:
+	int add(const string &name, const function<void()> &f, const vector<int> &after = {});
+	void run(JobSystem &jobs);
+	void clear() { tasks.clear(); }
+
+	struct Task {
+		string name;
+		function<void()> f;
+		vector<int> next;		// tasks waiting on this one
+		int deps = 0;
+		atomic<int> waiting { 0 };
+		double ms = 0;			// time taken on the last run
+	};
+
+	vector<unique_ptr<Task>> tasks;
+
+private:
+	static void runTask(void *graph, int index);
+
+	JobSystem *jobs = NULL;
+	JobCounter done;
+};
@@ -0,0 +1,131 @@
+#include "Level.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+// Each fleet flies 15 ships on one path, then 15 on the next.
+const char *DEFAULT_LEVEL =
+	"archetype grunt 100 0.24 8 aimed\n"
+	"fleet left 0.25\n"
+	"fleet right 0.75 mirror\n"
+	"fleet middle 0.5\n"
+	"spawn 0 left grunt wave 15 0.5\n"
+	"spawn 7.5 left grunt wave-tight 15 0.5\n"
+	"spawn 15 left grunt wave 15 0.5\n"
+	"spawn 22.5 left grunt wave-tight 15 0.5\n"
+	"spawn 0 right grunt wave 15 0.5\n"
+	"spawn 7.5 right grunt wave-tight 15 0.5\n"
+	"spawn 15 right grunt wave 15 0.5\n"
+	"spawn 22.5 right grunt wave-tight 15 0.5\n"
+	"spawn 0 middle grunt line 15 1\n"
+	"spawn 15 middle grunt line-tight 15 1\n"
+	"loop 30\n";
+
+bool Level::load(const string &file) {
+	ifstream in(file);
+	if (!in) return false;
+	stringstream text;
+	text << in.rdbuf();
+	return parse(text.str()) > 0;
+}
+
+// Read statements, adding to what's already loaded.
+int Level::parse(const string &text) {
+	source += text;
+	istringstream lines(text);
+	string line;
+	int count = 0;
+	while (getline(lines, line)) {
+		istringstream words(line);
+		string cmd, flag;
+		if (!(words >> cmd) || cmd[0] == '#') continue;
+
+		if (cmd == "archetype") {
+			ShipArchetype a;
+			if (!(words >> a.name >> a.speed >> a.fire >> a.life)) continue;
+			if (words >> flag) { a.aimed = flag != "down"; }
+			archetypes.push_back(a);
+		}
+		else if (cmd == "fleet") {
+			FleetDef f;
+			if (!(words >> f.name >> f.x)) continue;
+			f.mirror = (words >> flag) && flag == "mirror";
+			fleets.push_back(f);
+		}
+		else if (cmd == "spawn") {
+			SpawnRule r;
+			if (!(words >> r.start >> r.fleet >> r.archetype >> r.path)) continue;
+			if (!(words >> r.count)) { r.count = 1; }
+			if (!(words >> r.every)) { r.every = 1; }
+			rules.push_back(r);
+		}
+		else if (cmd == "loop") {
+			if (!(words >> loop)) continue;
+		}
+		else {
+			ofLogWarning("Level") << "unknown statement " << cmd;
+			continue;
+		}
+		count++;
+	}
+	return count;
+}
+
+template <class T> static int findName(const vector<T> &v, const string &name) {
+	for (int i = 0; i < v.size(); i++) {
+		if (v[i].name == name) return i;
+	}
+	return -1;
+}
+
+// Expand the spawn rules into one event per ship, sorted by the tick it
+// launches on. Events on the same tick keep file order. Rules naming a fleet
+// or archetype that doesn't exist are dropped; an unknown path flies
+// straight.
+void Level::compile(PathLibrary &paths) {
+	timeline.clear();
+	for (SpawnRule &r : rules) {
+		int fleet = findName(fleets, r.fleet);
+		int archetype = findName(archetypes, r.archetype);
+		if (fleet < 0 || archetype < 0) {
+			ofLogWarning("Level") << "spawn at " << r.start << "s names an unknown fleet or archetype";
+			continue;
+		}
+		int path = paths.find(r.path);
+		for (int i = 0; i < r.count; i++) {
+			double start = max(0.0, (double)r.start + i * r.every);
+			timeline.push_back({ (Tick)llround(start * TICK_RATE), fleet, archetype, path });
+		}
+	}
+	stable_sort(timeline.begin(), timeline.end(), [](const SpawnEvent &a, const SpawnEvent &b) { return a.tick < b.tick; });
+
+	// A pass can't start before the previous one has launched everything,
+	// and must take at least a tick, or the spawner would never catch up.
+	period = loop > 0 ? (Tick)llround((double)loop * TICK_RATE) : 0;
+	if (loop > 0 && (period == 0 || (!timeline.empty() && period < timeline.back().tick))) {
+		ofLogWarning("Level") << "loop " << loop << "s is shorter than the last spawn, playing the spawns once";
+		period = 0;
+	}
+}
+
+void Spawner::start(const Level *l, Tick now) {
+	level = l;
+	cursor = 0;
+	offset = now;
+}
+
+// Events come out in order, each once per pass. A looping level starts its
+// next pass loop seconds after the previous one started.
+const SpawnEvent *Spawner::next(Tick now) {
+	if (level == NULL || level->timeline.empty()) return NULL;
+	if (cursor == level->timeline.size()) {
+		if (level->period == 0) return NULL;
+		cursor = 0;
+		offset += level->period;
+	}
+	const SpawnEvent &e = level->timeline[cursor];
+	if (offset + e.tick > now) return NULL;
+	cursor++;
+	return &e;
+}
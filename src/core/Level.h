@@ -0,0 +1,81 @@
+#pragma once
+
+#include "ofMain.h"
+#include "GameClock.h"
+#include "Paths.h"
+
+// A level: the kinds of ship, the fleets that launch them and when each
+// ship launches, read from text one statement per line:
+//   archetype <name> <speed> <fire> <life> [aimed|down]
+//       flies its path at speed px/s, fires fire shots/sec on average, lives
+//       life seconds, shooting at the player or straight down.
+//   fleet <name> <x> [mirror]
+//       launches ships from x, a fraction of the field width. Mirrored fleets
+//       fly their paths flipped left to right.
+//   spawn <start> <fleet> <archetype> <path> [count] [every]
+//       count ships (1) from start seconds on, every seconds (1) apart.
+//   loop <seconds>
+//       play the spawns again every <seconds> from the start of the previous
+//       pass. A loop shorter than the last spawn, or than a tick, is
+//       ignored and the spawns play once.
+// Lines starting with # are comments. Once loaded, compile() turns the
+// spawns into one timeline sorted by time.
+
+// Built-in level, the three fleets the game always had.
+extern const char *DEFAULT_LEVEL;
+
+struct ShipArchetype {
+	string name;
+	float speed = 100;	// px/s along the path
+	float fire = 0.24;	// shots/sec
+	float life = 8;		// sec
+	bool aimed = true;	// shots at the player, or straight down
+};
+
+struct FleetDef {
+	string name;
+	float x = 0.5;
+	bool mirror = false;
+};
+
+// One ship to launch: when (ticks from the start of the level), from which
+// fleet, what kind and on which path.
+struct SpawnEvent {
+	Tick tick;
+	int fleet;
+	int archetype;
+	int path;
+};
+
+class Level {
+public:
+	bool load(const string &file);
+	int parse(const string &text);		// returns the number of statements read
+	void compile(PathLibrary &paths);
+	bool empty() { return fleets.empty(); }
+
+	struct SpawnRule {
+		float start, every;
+		int count;
+		string fleet, archetype, path;
+	};
+
+	vector<ShipArchetype> archetypes;
+	vector<FleetDef> fleets;
+	vector<SpawnRule> rules;
+	string source;				// all the text parsed, in order
+	float loop = 0;				// sec, 0 plays the timeline once
+	Tick period = 0;			// loop in ticks, 0 if it doesn't, once compiled
+	vector<SpawnEvent> timeline;	// sorted by tick, once compiled
+};
+
+// Walks a compiled level's timeline as the game clock passes it.
+class Spawner {
+public:
+	void start(const Level *level, Tick now);
+	const SpawnEvent *next(Tick now);	// next event due by now, or NULL
+
+	const Level *level = NULL;
+	int cursor = 0;
+	Tick offset = 0;	// tick the current pass started on
+};
@@ -0,0 +1,140 @@
+#include "Paths.h"
+
+#include <fstream>
+#include <sstream>
+
+const char *DEFAULT_PATHS =
+	"wave sine 75 2\n"
+	"wave-tight sine 42 12\n"
+	"line triangle 75 12\n"
+	"line-tight triangle 42 22\n";
+
+// Points on the dense curve for each path kind.
+static const int CURVE_SAMPLES = 2048;
+static const int SEGMENT_SAMPLES = 64;
+
+glm::vec2 PathTable::at(float s) const {
+	int n = points.size();
+	if (n == 0) return endDir * max(s, 0.0f);	// no curve, fly straight
+	if (s <= 0) return points[0];
+	if (n == 1) return points[0] + endDir * s;
+	float f = s / spacing;
+	int i = (int)f;
+	if (i >= n - 1) { return points[n - 1] + endDir * (s - length); }
+	return glm::mix(points[i], points[i + 1], f - i);
+}
+
+// Walk the curve and drop a point every spacing pixels along it.
+void PathTable::build(const vector<glm::vec2> &curve) {
+	points.clear();
+	length = 0;
+	if (curve.empty()) return;
+	points.push_back(curve[0]);
+	float next = spacing;
+	for (int i = 1; i < curve.size(); i++) {
+		glm::vec2 a = curve[i - 1], b = curve[i];
+		float seg = glm::distance(a, b);
+		while (seg > 0 && length + seg >= next) {
+			points.push_back(glm::mix(a, b, (next - length) / seg));
+			next += spacing;
+		}
+		length += seg;
+	}
+
+	// Shorter than one spacing, fly off its start towards its end, or
+	// straight down if it goes nowhere.
+	if (points.size() == 1) {
+		glm::vec2 d = curve.back() - curve[0];
+		endDir = length > 0 && glm::length(d) > 0 ? glm::normalize(d) : glm::vec2(0, 1);
+		return;
+	}
+	length = (points.size() - 1) * spacing;
+	endDir = glm::normalize(points[points.size() - 1] - points[points.size() - 2]);
+}
+
+bool PathLibrary::load(const string &file) {
+	ifstream in(file);
+	if (!in) return false;
+	stringstream text;
+	text << in.rdbuf();
+	return parse(text.str()) > 0;
+}
+
+// Read definitions, replacing any with the same name.
+int PathLibrary::parse(const string &text) {
+	source += text;
+	istringstream lines(text);
+	string line;
+	int count = 0;
+	while (getline(lines, line)) {
+		istringstream words(line);
+		PathDef def;
+		if (!(words >> def.name) || def.name[0] == '#' || !(words >> def.kind)) continue;
+		float v;
+		while (words >> v) { def.args.push_back(v); }
+
+		int id = find(def.name);
+		if (id < 0) { defs.push_back(def); }
+		else { defs[id] = def; }
+		count++;
+	}
+	return count;
+}
+
+// Cubic Bezier or Catmull-Rom segment point, t from 0 to 1.
+static glm::vec2 bezier(glm::vec2 a, glm::vec2 b, glm::vec2 c, glm::vec2 d, float t) {
+	float u = 1 - t;
+	return u * u * u * a + 3 * u * u * t * b + 3 * u * t * t * c + t * t * t * d;
+}
+
+static glm::vec2 catmull(glm::vec2 a, glm::vec2 b, glm::vec2 c, glm::vec2 d, float t) {
+	return 0.5f * (2.0f * b + (c - a) * t + (2.0f * a - 5.0f * b + 4.0f * c - d) * t * t + (3.0f * b - a - 3.0f * c + d) * t * t * t);
+}
+
+// Bake every definition into a table for a field this high. The waves match
+// the formulas the fleets used before, with y running down the field.
+void PathLibrary::build(float fieldHeight) {
+	tables.resize(defs.size());
+	vector<glm::vec2> curve;
+	for (int p = 0; p < defs.size(); p++) {
+		PathDef &def = defs[p];
+		vector<float> &a = def.args;
+		curve.clear();
+		if ((def.kind == "sine" || def.kind == "triangle") && a.size() >= 2) {
+			for (int i = 0; i <= CURVE_SAMPLES; i++) {
+				float y = fieldHeight * i / CURVE_SAMPLES;
+				float x;
+				if (def.kind == "sine") { x = -a[0] * sin(a[1] * y * PI / fieldHeight); }
+				else { x = -a[0] * (asin(cos(a[1] * y / fieldHeight)) / (PI / 2)); }
+				curve.push_back(glm::vec2(x, y));
+			}
+		}
+		else if (def.kind == "catmull" || def.kind == "bezier") {
+			vector<glm::vec2> pts;
+			for (int i = 0; i + 1 < a.size(); i += 2) { pts.push_back(glm::vec2(a[i], a[i + 1] * fieldHeight)); }
+			if (def.kind == "catmull" && pts.size() >= 2) {
+				for (int i = 0; i + 1 < pts.size(); i++) {
+					glm::vec2 p0 = pts[max(i - 1, 0)], p3 = pts[min(i + 2, (int)pts.size() - 1)];
+					for (int k = 0; k < SEGMENT_SAMPLES; k++) { curve.push_back(catmull(p0, pts[i], pts[i + 1], p3, (float)k / SEGMENT_SAMPLES)); }
+				}
+				curve.push_back(pts.back());
+			}
+			else if (def.kind == "bezier" && pts.size() >= 4) {
+				for (int i = 0; i + 3 < pts.size(); i += 3) {
+					for (int k = 0; k < SEGMENT_SAMPLES; k++) { curve.push_back(bezier(pts[i], pts[i + 1], pts[i + 2], pts[i + 3], (float)k / SEGMENT_SAMPLES)); }
+				}
+				curve.push_back(pts[(pts.size() - 1) / 3 * 3]);
+			}
+		}
+		if (curve.empty()) { ofLogWarning("PathLibrary") << "path " << def.name << " has a bad " << def.kind << " definition"; }
+		tables[p].name = def.name;
+		tables[p].build(curve);
+	}
+}
+
+int PathLibrary::find(const string &name) {
+	for (int i = 0; i < defs.size(); i++) {
+		if (defs[i].name == name) return i;
+	}
+	return -1;
+}
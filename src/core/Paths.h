@@ -0,0 +1,52 @@
+#pragma once
+
+#include "ofMain.h"
+
+// Paths the enemy ships fly, baked into lookup tables by arc length. A
+// ship's position is then the table entry for the distance it has flown,
+// lerped with the next one, instead of a sin or asin per ship per tick.
+//
+// Paths are defined one per line of text, "name kind numbers...":
+//   sine <amplitude> <cycles>      across the field height, like the old wave
+//   triangle <amplitude> <cycles>  the old zig zag line
+//   catmull x y x y ...            Catmull-Rom through the points
+//   bezier x y x y ...             cubic Bezier segments, 3n + 1 points
+// x is in pixels from the fleet, y is a fraction of the field height. Lines
+// starting with # are comments.
+
+// Built-in definitions, used when no paths file is loaded.
+extern const char *DEFAULT_PATHS;
+
+// One path, sampled every spacing pixels along the curve. Flown past the
+// end, it carries on in a straight line.
+struct PathTable {
+	string name;
+	vector<glm::vec2> points;
+	glm::vec2 endDir = glm::vec2(0, 1);	// heading off the end
+	float spacing = 2;
+	float length = 0;
+
+	glm::vec2 at(float s) const;
+	void build(const vector<glm::vec2> &curve);
+};
+
+class PathLibrary {
+public:
+	bool load(const string &file);
+	int parse(const string &text);		// returns the number of paths read
+	void build(float fieldHeight);
+	bool empty() { return defs.empty(); }
+
+	int find(const string &name);		// -1 if there is no such path
+	const PathTable &get(int id) const { return tables[id]; }
+
+	struct PathDef {
+		string name;
+		string kind;
+		vector<float> args;
+	};
+
+	vector<PathDef> defs;
+	string source;		// all the text parsed, in order
+	vector<PathTable> tables;	// same order as defs, once built
+};
@@ -0,0 +1,63 @@
+#include "PowerUp.h"
+
+// Modified by Michael Kang for CS134 Project 1.
+
+//
+// Powerup Control:
+// Uses physics based movement.
+//
+PowerUp::PowerUp() {
+	trans = ofVec3f(view.width / 2, 1, 0);
+	heading = ofVec3f(0, 1, 0);
+	velocity = heading * 10;
+	acceleration = ofVec3f(0, 0, 0);
+	damping = 0.99;
+	prevTrans = trans;
+	hidden = false;
+}
+
+void PowerUp::draw(SpriteBatch &batch, float alpha) {
+	if (!hidden) { 
+		glm::vec3 pos = lerpTrans(alpha);
+		ofDrawSphere(pos, 5);
+		Profiler::get().count(CountDrawCalls);
+		batch.add(image, pos.x, pos.y);
+	}
+}
+
+// Reset position and parameters.
+void PowerUp::reset() {
+	trans = ofVec3f(view.width / 2, 1, 0);
+	heading = ofVec3f(0, 1, 0);
+	velocity = heading * 10;
+	acceleration = ofVec3f(0, 0, 0);
+	prevTrans = trans;
+	hidden = false;
+}
+
+// Use physics based movement with screen limiters to produce a bounce effect.
+void PowerUp::integrate() {
+	if (trans.x <= 0 || trans.x >= view.width) {
+		heading.x = -heading.x;
+		velocity.x = -velocity.x;
+	}
+	if (trans.y <= 0 || trans.y >= view.height) {
+		heading.y = -heading.y;
+		velocity.y = -velocity.y;
+	}
+	if (velocity.length() <= 20) {
+		heading.rotate(rng->range(-90, 90), ofVec3f(0, 0, 1));
+		acceleration = heading * 5000;
+	}
+
+	// Calculate position:
+	prevTrans = trans;
+	trans += velocity * TICK_DT;
+	velocity += acceleration * TICK_DT;
+	velocity *= damping;
+	acceleration = ofVec3f(0, 0, 0);
+}
+
+float PowerUp::hitRadius() {
+	return velocity.length() / TUNED_FRAMERATE;
+}
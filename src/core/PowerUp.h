@@ -0,0 +1,30 @@
+#pragma once
+
+#include "ofMain.h"
+#include "Random.h"
+#include "Sprite.h"
+#include "Viewport.h"
+
+// Modified by Michael Kang for CS134 Project 1.
+
+// Power Up class that utilizes physics based movement to traverse the map
+// at random directions and will bounce off the edges of screen.
+class PowerUp : public BaseObject {
+public:
+	PowerUp();
+
+	void integrate();
+	void draw(SpriteBatch &batch, float alpha = 1);
+	void reset();
+	float hitRadius();
+
+	// Data:
+	ofVec3f velocity;
+	ofVec3f acceleration;
+	ofVec3f heading;
+	TextureHandle image;
+	Random *rng = NULL;		// picks a new heading when slowing down
+	Viewport view;			// edges to bounce off
+	float damping;
+	bool hidden;
+};
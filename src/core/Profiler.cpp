@@ -0,0 +1,66 @@
+#include "Profiler.h"
+
+#include <cstdio>
+
+Profiler &Profiler::get() {
+	static Profiler profiler;
+	return profiler;
+}
+
+// Find or add a zone. Past the zone limit everything lands in the last one.
+int Profiler::zone(const string &name) {
+	for (int i = 0; i < zones.size(); i++) {
+		if (zones[i] == name) return i;
+	}
+	if (zones.size() == MAX_PROFILE_ZONES) return MAX_PROFILE_ZONES - 1;
+	zones.push_back(name);
+	return zones.size() - 1;
+}
+
+// Publish the current frame and start a new one.
+void Profiler::endFrame() {
+	uint64_t n = written.load(memory_order_relaxed);
+	current.frame = n;
+	ring[n & (PROFILE_RING_SIZE - 1)] = current;
+	written.store(n + 1, memory_order_release);
+	current = ProfileFrame();
+}
+
+void Profiler::latest(int n, vector<ProfileFrame> &out) {
+	uint64_t end = written.load(memory_order_acquire);
+	uint64_t count = min<uint64_t>(min<uint64_t>(n, end), PROFILE_RING_SIZE);
+	out.clear();
+	for (uint64_t f = end - count; f < end; f++) { out.push_back(ring[f & (PROFILE_RING_SIZE - 1)]); }
+}
+
+// One row per frame: frame number, ms per zone, then the counters.
+bool Profiler::writeCsv(const string &path, int n) {
+	FILE *f = fopen(path.c_str(), "w");
+	if (f == NULL) return false;
+	vector<ProfileFrame> frames;
+	latest(n, frames);
+
+	fprintf(f, "frame");
+	for (string &z : zones) { fprintf(f, ",%s ms", z.c_str()); }
+	for (int c = 0; c < NUM_PROFILE_COUNTERS; c++) { fprintf(f, ",%s", counterName((ProfileCounter)c)); }
+	fprintf(f, "\n");
+	for (ProfileFrame &p : frames) {
+		fprintf(f, "%llu", (unsigned long long)p.frame);
+		for (int z = 0; z < zones.size(); z++) { fprintf(f, ",%.4f", p.ms[z]); }
+		for (int c = 0; c < NUM_PROFILE_COUNTERS; c++) { fprintf(f, ",%d", p.counters[c]); }
+		fprintf(f, "\n");
+	}
+	fclose(f);
+	return true;
+}
+
+const char *Profiler::counterName(ProfileCounter c) {
+	switch (c) {
+	case CountDrawCalls: return "draw calls";
+	case CountShips: return "ships";
+	case CountShots: return "shots";
+	case CountDebris: return "debris";
+	case CountExplosions: return "explosions";
+	default: return "";
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Counts recorded alongside the zone timings each frame.
+enum ProfileCounter { CountDrawCalls, CountShips, CountShots, CountDebris, CountExplosions, NUM_PROFILE_COUNTERS };
+
+const int MAX_PROFILE_ZONES = 32;
+const int PROFILE_RING_SIZE = 1024;	// frames kept, a power of two
+
+// Everything recorded over one frame. Zones entered more than once in a
+// frame (once per tick, once per fleet) add up.
+struct ProfileFrame {
+	uint64_t frame = 0;
+	float ms[MAX_PROFILE_ZONES] = {};
+	int calls[MAX_PROFILE_ZONES] = {};
+	int counters[NUM_PROFILE_COUNTERS] = {};
+};
+
+// Frame profiler. Timed zones and counters accumulate into the current
+// frame, which endFrame() pushes onto a ring of recent frames. The ring has
+// a single writer, the game thread, which publishes each frame with one
+// atomic store, so readers never take a lock.
+//
+class Profiler {
+public:
+	static Profiler &get();
+
+	// Zone ids are handed out by name, the same name always gets the same id.
+	int zone(const string &name);
+	void record(int zone, double ms) { current.ms[zone] += ms; current.calls[zone]++; }
+	void count(ProfileCounter c, int n = 1) { current.counters[c] += n; }
+	void set(ProfileCounter c, int n) { current.counters[c] = n; }
+	void endFrame();
+
+	// Copy out up to n of the latest frames, oldest first.
+	void latest(int n, vector<ProfileFrame> &out);
+	bool writeCsv(const string &path, int n);
+
+	static const char *counterName(ProfileCounter c);
+
+	vector<string> zones;
+	ProfileFrame current;
+	ProfileFrame ring[PROFILE_RING_SIZE];
+	atomic<uint64_t> written { 0 };		// frames pushed so far
+};
+
+// Times the enclosing block into a zone.
+class ProfileScope {
+public:
+	ProfileScope(int z) : zone(z), start(chrono::steady_clock::now()) {}
+	~ProfileScope() {
+		chrono::duration<double, milli> ms = chrono::steady_clock::now() - start;
+		Profiler::get().record(zone, ms.count());
+	}
+
+	int zone;
+	chrono::steady_clock::time_point start;
+};
+
+// Time the rest of the enclosing block under a fixed zone name.
+#define PROFILE_CAT2(a, b) a##b
+#define PROFILE_CAT(a, b) PROFILE_CAT2(a, b)
+#define PROFILE_ZONE(name) \
+	static int PROFILE_CAT(profileZone, __LINE__) = Profiler::get().zone(name); \
+	ProfileScope PROFILE_CAT(profileScope, __LINE__)(PROFILE_CAT(profileZone, __LINE__))
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+// Small fast random number generator (xoshiro128**) for the simulation.
+// Each subsystem owns its own stream, seeded from the game seed and a stream
+// number, so the same seed replays the same game and streams never share
+// state.
+//
+class Random {
+public:
+	Random() { seed(0, 0); }
+	Random(uint64_t s, uint64_t stream) { seed(s, stream); }
+
+	// Expand seed and stream into the generator state with splitmix64.
+	void seed(uint64_t s, uint64_t stream) {
+		uint64_t x = s ^ (stream * 0xD1B54A32D192ED03ull);
+		for (int i = 0; i < 4; i += 2) {
+			uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			z ^= z >> 31;
+			state[i] = (uint32_t)z;
+			state[i + 1] = (uint32_t)(z >> 32);
+		}
+	}
+
+	uint32_t next() {
+		uint32_t result = rotl(state[1] * 5, 7) * 9;
+		uint32_t t = state[1] << 9;
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = rotl(state[3], 11);
+		return result;
+	}
+
+	// Uniform in [lo, hi), from the top 24 bits.
+	float range(float lo, float hi) { return lo + (hi - lo) * ((next() >> 8) * (1.0f / 16777216.0f)); }
+
+	// Wait until the next event of a Poisson process with the given mean.
+	float exponential(float mean) { return -mean * logf(1 - range(0, 1)); }
+
+	uint32_t state[4];
+
+private:
+	static uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+};
+
+// Stream numbers for the simulation's subsystems. Fleets take one stream
+// each starting at StreamFleet.
+enum RandomStream { StreamDebris = 1, StreamPower, StreamFleet };
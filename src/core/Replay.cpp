@@ -0,0 +1,134 @@
+#include "Replay.h"
+
+#include <cstring>
+
+// Modified by Michael Kang for CS134 Project 1.
+
+// File layout: magic, version, seed, view, data hash, event count, events, hash count,
+// hashes. Little endian, as written by the machines we run on.
+static const char REPLAY_MAGIC[4] = { 'S', 'W', 'R', 'P' };
+// Bumped whenever gameplay changes enough that older recordings can't match.
+static const uint32_t REPLAY_VERSION = 10;
+
+static uint8_t packButtons(const TickInput &input) {
+	uint8_t b = input.shoot ? 1 : 0;
+	for (int k = MoveLeft; k <= MoveDown; k++) {
+		if (input.keys[k]) { b |= 1 << k; }
+	}
+	return b;
+}
+
+// Start a new recording for a session run with this seed, view and data.
+void Recording::begin(uint64_t s, Viewport v, uint64_t data) {
+	seed = s;
+	view = v;
+	dataHash = data;
+	events.clear();
+	hashes.clear();
+	rewind();
+}
+
+// Store the input for a tick, if it changed since the last one stored.
+void Recording::record(uint32_t tick, const TickInput &input) {
+	uint8_t b = packButtons(input);
+	if (b == lastButtons && input.drag.x == 0 && input.drag.y == 0) return;
+	InputEvent e;
+	e.tick = tick;
+	e.buttons = b;
+	e.dx = input.drag.x;
+	e.dy = input.drag.y;
+	events.push_back(e);
+	lastButtons = b;
+}
+
+void Recording::rewind() {
+	cursor = 0;
+	lastButtons = 0;
+	divergedAt = -1;
+}
+
+// Rebuild the input for a tick. Keys hold their state until the next event,
+// drags only apply on the tick they were recorded on.
+TickInput Recording::input(uint32_t tick) {
+	TickInput in;
+	while (cursor < events.size() && events[cursor].tick < tick) { lastButtons = events[cursor++].buttons; }
+	if (cursor < events.size() && events[cursor].tick == tick) {
+		InputEvent &e = events[cursor++];
+		lastButtons = e.buttons;
+		in.drag = ofVec3f(e.dx, e.dy, 0);
+	}
+	in.shoot = lastButtons & 1;
+	for (int k = MoveLeft; k <= MoveDown; k++) { in.keys[k] = (lastButtons >> k) & 1; }
+	return in;
+}
+
+// Compare the state after a tick against the recording. Remembers the first
+// tick that differs. Ticks past the end of the recording are not checked.
+bool Recording::verify(uint32_t tick, uint64_t h) {
+	if (tick >= hashes.size() || hashes[tick] == h) return true;
+	if (divergedAt < 0) { divergedAt = tick; }
+	return false;
+}
+
+bool Recording::save(const string &path) {
+	ofstream out(path, ios::binary);
+	if (!out) return false;
+	uint32_t count = events.size();
+	out.write(REPLAY_MAGIC, 4);
+	out.write((const char *)&REPLAY_VERSION, sizeof(REPLAY_VERSION));
+	out.write((const char *)&seed, sizeof(seed));
+	out.write((const char *)&view.width, sizeof(view.width));
+	out.write((const char *)&view.height, sizeof(view.height));
+	out.write((const char *)&dataHash, sizeof(dataHash));
+	out.write((const char *)&count, sizeof(count));
+	for (InputEvent &e : events) {
+		out.write((const char *)&e.tick, sizeof(e.tick));
+		out.write((const char *)&e.buttons, sizeof(e.buttons));
+		out.write((const char *)&e.dx, sizeof(e.dx));
+		out.write((const char *)&e.dy, sizeof(e.dy));
+	}
+	count = hashes.size();
+	out.write((const char *)&count, sizeof(count));
+	out.write((const char *)hashes.data(), count * sizeof(uint64_t));
+	return (bool)out;
+}
+
+// Each event on disk, packed without padding.
+static const size_t EVENT_SIZE = sizeof(uint32_t) + sizeof(uint8_t) + 2 * sizeof(float);
+
+// Read a recording back. Fails on a short or corrupt file rather than trusting
+// the counts in it, so a bad count can't size a huge allocation.
+bool Recording::load(const string &path) {
+	ifstream in(path, ios::binary | ios::ate);
+	if (!in) return false;
+	uint64_t remaining = in.tellg();
+	in.seekg(0);
+	char magic[4];
+	uint32_t version = 0, count = 0;
+	if (!in.read(magic, 4) || memcmp(magic, REPLAY_MAGIC, 4) != 0) return false;
+	if (!in.read((char *)&version, sizeof(version)) || version != REPLAY_VERSION) return false;
+	if (!in.read((char *)&seed, sizeof(seed))) return false;
+	if (!in.read((char *)&view.width, sizeof(view.width))) return false;
+	if (!in.read((char *)&view.height, sizeof(view.height))) return false;
+	if (!in.read((char *)&dataHash, sizeof(dataHash))) return false;
+	if (!in.read((char *)&count, sizeof(count))) return false;
+
+	remaining -= in.tellg();
+	if (count > remaining / EVENT_SIZE) return false;
+	events.resize(count);
+	for (InputEvent &e : events) {
+		if (!in.read((char *)&e.tick, sizeof(e.tick))) return false;
+		if (!in.read((char *)&e.buttons, sizeof(e.buttons))) return false;
+		if (!in.read((char *)&e.dx, sizeof(e.dx))) return false;
+		if (!in.read((char *)&e.dy, sizeof(e.dy))) return false;
+	}
+	remaining -= count * EVENT_SIZE;
+
+	if (!in.read((char *)&count, sizeof(count))) return false;
+	remaining -= sizeof(count);
+	if (count > remaining / sizeof(uint64_t)) return false;
+	hashes.resize(count);
+	if (!in.read((char *)hashes.data(), count * sizeof(uint64_t))) return false;
+	rewind();
+	return true;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "ofMain.h"
+#include "Simulation.h"
+
+// Modified by Michael Kang for CS134 Project 1.
+
+// Input for one tick that differs from the tick before it. Ticks with the
+// same keys and no mouse drag are not stored.
+struct InputEvent {
+	uint32_t tick;
+	uint8_t buttons;	// bit per MoveDir key, bit 0 is shoot
+	float dx, dy;		// mouse drag applied this tick
+};
+
+// A recorded session: the seed, play field and level data it ran with, its
+// input as events stamped with tick numbers, and the state hash after every
+// tick.
+// Playing it back through a Simulation set up the same way must produce the
+// same hashes, so the first mismatch shows where gameplay changed.
+//
+class Recording {
+public:
+	void begin(uint64_t seed, Viewport view, uint64_t data);
+	void record(uint32_t tick, const TickInput &input);
+	void hash(uint64_t h) { hashes.push_back(h); }
+
+	// Playback. Ticks must be asked for in order starting from 0.
+	void rewind();
+	TickInput input(uint32_t tick);
+	bool verify(uint32_t tick, uint64_t h);
+
+	bool save(const string &path);
+	bool load(const string &path);
+
+	uint64_t seed = 0;
+	Viewport view;
+	uint64_t dataHash = 0;		// Simulation::dataHash() of the level and paths
+	vector<InputEvent> events;
+	vector<uint64_t> hashes;	// state hash after each tick
+
+	int cursor = 0;				// next event to play back
+	uint8_t lastButtons = 0;
+	int divergedAt = -1;		// first tick whose hash differed, -1 if none
+};
@@ -0,0 +1,497 @@
+#include "Simulation.h"
+
+// Modified by Michael Kang for CS134 Project 1.
+
+//
+// Setup:
+// Create the player, the enemy fleets and the power up. Everything is placed
+// relative to the play field size given by the host. Setting up again
+// replaces the last game.
+//
+void Simulation::setup(Clock *c, uint64_t s, Viewport v, const SimAssets &a) {
+	enemy.clear();
+	fleetZones.clear();
+	explosions.clear();
+	sounds.clear();
+	bGameStart = false;
+	bGameOver = false;
+	ticks = 0;
+	score = 0;
+	lives = 10;
+
+	clock = c;
+	clock->restart();
+	seed = s;
+	debrisRng.seed(seed, StreamDebris);
+	powerRng.seed(seed, StreamPower);
+	view = v;
+	assets = a;
+	defaultDir = ofVec3f(0, -1000, 0);
+
+	// Create player object.
+	playerShots.clear();
+	player = make_unique<Emitter>(&playerShots);
+	player->setPosition(ofVec3f(view.width / 2, view.height / 2, 0));
+	player->setVelocity(defaultDir);
+	player->setLifespan(2 * 1000);
+	player->setRate(8);
+	player->setImage(assets.ship);
+	player->setChildImage(assets.projectile);
+	player->setSound(assets.laserShot);
+	player->interpolate = false;
+
+	// Enemy template. The level sets each ship's speed, fire rate and life.
+	enemy1 = make_unique<Emitter>(&enemyShots);
+	enemy1->setPosition(ofVec3f(view.width / 4, 0, 0));
+	enemy1->setVelocity(ofVec3f(0, -100, 0));
+	enemy1->setLifespan(3000);
+	enemy1->setRate(0.5);
+	enemy1->setImage(assets.enemyShip);
+	enemy1->setChildImage(assets.enemyProj);
+	enemy1->isEnemy = true;
+
+	// Enemy paths and the level, baked for this field. The host may have
+	// loaded its own.
+	if (paths.empty()) { paths.parse(DEFAULT_PATHS); }
+	paths.build(view.height);
+	if (level.empty()) { level.parse(DEFAULT_LEVEL); }
+	level.compile(paths);
+
+	// A mama emitter for each of the level's fleets, launching copies of the
+	// enemy. Its spawner launches the ships.
+	for (FleetDef &f : level.fleets) {
+		unique_ptr<MamaEmitter> mama = make_unique<MamaEmitter>(enemy1.get());
+		mama->setPosition(ofVec3f(view.width * f.x, 0, 0));
+		mama->type = !f.mirror;
+		mama->library = &paths;
+		addFleet(move(mama));
+	}
+	spawner.start(&level, clock->tick());
+
+	// Explosions share the debris image and stream.
+	explosions.setImage(assets.explosion);
+	explosions.setRandom(&debrisRng);
+
+	// Set powerup image.
+	power.image = assets.powerShield;
+	power.rng = &powerRng;
+	power.view = view;
+	power.reset();
+	player->power = assets.shield;
+
+	// Broad phase collision grids over the play field.
+	shipGrid.setup(view.width, view.height, 32);
+	shotGrid.setup(view.width, view.height, 32);
+	buildTickGraph();
+
+	// Set screen limit parameters.
+	leftEdge = (player->width / 2);
+	topEdge = (player->height / 2);
+	rightEdge = view.width - (player->width / 2);
+	bottomEdge = view.height - (player->height / 2);
+}
+
+// Advance the game by one fixed step of TICK_DT seconds. The clock is read
+// once, every object sees the same time for the whole tick. The phases run
+// as a task graph, see buildTickGraph(). Timings are handed on from this
+// thread once the graph is done, sounds are left in sounds for the host.
+//
+void Simulation::tick(const TickInput &input) {
+	if (!bGameStart || bGameOver) return;
+
+	tickInput = &input;
+	tickNow = clock->tick();
+	sounds.clear();
+	frame.run(jobs);
+
+	Profiler &p = Profiler::get();
+	for (int i = 0; i < frame.tasks.size(); i++) { p.record(taskZones[i], frame.tasks[i]->ms); }
+	for (int i = 0; i < enemy.size(); i++) { p.record(fleetZones[i], fleetMs[i]); }
+
+	clock->advance();
+	ticks++;
+}
+
+// A tick's phases and what each waits for. Input comes first. Then the
+// fleets, the player's shots and the power up all move at once, each only
+// touching its own objects, while old debris moves on its own. Collisions
+// need everything in place, and explosions they set off spawn last.
+//
+void Simulation::buildTickGraph() {
+	frame.clear();
+	int input = frame.add("input", [this] { applyInput(*tickInput, tickNow); });
+	int fleets = frame.add("fleets", [this] { updateFleets(tickNow); }, { input });
+	int shots = frame.add("player update", [this] { updatePlayer(tickNow); }, { input });
+	int pow = frame.add("power", [this] { if (!power.hidden) { power.integrate(); } }, { input });
+	int debris = frame.add("explosions", [this] { explosions.update(tickNow); });
+	int grid = frame.add("collision grid", [this] { buildCollisionGrids(); }, { fleets });
+	int hits = frame.add("collisions", [this] { resolveCollisions(tickNow); }, { grid, shots, pow, debris });
+	frame.add("explosion spawns", [this] { explosions.spawn(tickNow); }, { hits });
+
+	taskZones.clear();
+	for (unique_ptr<TaskGraph::Task> &t : frame.tasks) { taskZones.push_back(Profiler::get().zone(t->name)); }
+}
+
+// Mouse drags and arrow keys move the player, the spacebar fires.
+void Simulation::applyInput(const TickInput &input, Tick now) {
+	// Mouse drags since the last tick, limited to the screen edges.
+	if (input.drag.x != 0 || input.drag.y != 0) {
+		player->trans += input.drag;
+		mouseMoveLimit();
+	}
+
+	// Player presses (or holds) spacebar to fire
+	if (input.shoot) {
+		if (!player->started) { player->start(now); }
+	}
+	else { player->stop(); }
+
+	// Movement based on player input using arrow keys.
+	// Limitations on movement based on window size.
+	keyMoveLimit(input);
+}
+
+// Ask the host to play a sound after this tick. Hits that land together
+// play it once.
+void Simulation::play(SoundHandle s) {
+	if (s && find(sounds.begin(), sounds.end(), s) == sounds.end()) { sounds.push_back(s); }
+}
+
+// Update player object/emitter, with a laser sound for each shot.
+void Simulation::updatePlayer(Tick now) {
+	player->update(now);
+	if (player->emitted && player->haveSound) { play(player->soundEffect); }
+}
+
+// Launch the ships the level has due, then update the fleets.
+// Update target vector based on player position. The time and the target
+// are all the fleets share, so once they're set each fleet can update on its
+// own thread.
+void Simulation::updateFleets(Tick now) {
+	while (const SpawnEvent *s = spawner.next(now)) {
+		enemy[s->fleet]->spawn(now, s->path, level.archetypes[s->archetype]);
+	}
+	for (unique_ptr<MamaEmitter> &e : enemy) { e->target = player->trans; }
+	fleetMs.resize(enemy.size());
+	jobs.parallelFor(enemy.size(), [this, now](int i) { updateFleet(i, now); });
+}
+
+// Update one fleet. Runs on a worker thread, so it must only touch the
+// fleet's own state.
+void Simulation::updateFleet(int i, Tick now) {
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+	MamaEmitter *e = enemy[i].get();
+	if (!e->started) { e->start(now); }
+	e->update(now);
+	fleetMs[i] = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+}
+
+// Collisions with the power up, the player and the player's shots.
+void Simulation::resolveCollisions(Tick now) {
+	// Check if player retrieved powerup.
+	powerCollisions(now);
+
+	// If player picked up powerup, is invincible for 15s.
+	if (!player->hasPower) { playerCollisions(now); }
+	else {
+		if (now - player->powertime >= 10 * TICK_RATE) {
+			player->hasPower = false;
+			power.hidden = false;
+			power.reset();
+		}
+	}
+	checkCollisions(now);
+
+	// Next step's swept tests start from here.
+	player->prevTrans = player->trans;
+}
+
+// Add an enemy fleet with the next random stream. Fleets past the eighth
+// share a profiler zone.
+void Simulation::addFleet(unique_ptr<MamaEmitter> e) {
+	int i = enemy.size();
+	e->random.seed(seed, StreamFleet + i);
+	e->target = player->trans;
+	enemy.push_back(move(e));
+	fleetZones.push_back(Profiler::get().zone(i < 8 ? "fleet " + ofToString(i + 1) : "fleets 9+"));
+}
+
+// Draw the game objects between their last two ticks.
+void Simulation::draw(float alpha) {
+	batch.begin();
+	{
+		PROFILE_ZONE("draw player");
+		player->draw(batch, alpha);
+		if (!power.hidden) { power.draw(batch, alpha); }
+	}
+	{
+		PROFILE_ZONE("draw fleets");
+		for (unique_ptr<MamaEmitter> &e : enemy) { e->draw(batch, alpha); }
+	}
+	{
+		PROFILE_ZONE("draw explosions");
+		explosions.draw(batch, alpha);
+	}
+	{
+		PROFILE_ZONE("draw submit");
+		batch.end();
+	}
+	countEntities();
+}
+
+// Entity counts for the profiler, once per drawn frame.
+void Simulation::countEntities() {
+	int ships = 0, shots = player->sys->size(), debris = 0;
+	for (unique_ptr<MamaEmitter> &e : enemy) {
+		ships += e->emitters.size();
+		for (int i = 0; i < e->emitters.size(); i++) { shots += e->emitters[i].sys->size(); }
+	}
+	debris = explosions.debris.size();
+	Profiler &p = Profiler::get();
+	p.set(CountShips, ships);
+	p.set(CountShots, shots);
+	p.set(CountDebris, debris);
+	p.set(CountExplosions, explosions.size());
+}
+
+//
+// Movement Control:
+//
+void Simulation::keyMoveLimit(const TickInput &input) {
+	// Check bool table for any keys pressed, and apply movement to player object.
+	// If at the edge, set position to that edge.
+	float step = moveSpeed * TICK_DT;
+	if (input.keys[MoveLeft] == true) {
+		if (player->trans.x <= leftEdge) { player->trans.x = leftEdge; }
+		else { player->trans += ofVec3f(-step, 0, 0); }
+	}
+	if (input.keys[MoveRight] == true) {
+		if (player->trans.x >= rightEdge) { player->trans.x = rightEdge; }
+		else { player->trans += ofVec3f(step, 0, 0); }
+	}
+	if (input.keys[MoveUp] == true) {
+		if (player->trans.y <= topEdge) { player->trans.y = topEdge; }
+		else { player->trans += ofVec3f(0, -step, 0); }
+	}
+	if (input.keys[MoveDown] == true) {
+		if (player->trans.y >= bottomEdge) { player->trans.y = bottomEdge; }
+		else { player->trans += ofVec3f(0, step, 0); }
+	}
+}
+
+void Simulation::mouseMoveLimit() {
+	// Check if at screen edge and halt movement if it is.
+	if (player->trans.x <= leftEdge) {
+		player->trans.x = leftEdge;
+		// Check if hit top/bottom edge while moving diagonally.
+		if (player->trans.y <= topEdge) { player->trans.y = topEdge; }
+		if (player->trans.y >= bottomEdge) { player->trans.y = bottomEdge; }
+	}
+	else if (player->trans.x >= rightEdge) {
+		player->trans.x = rightEdge;
+		if (player->trans.y <= topEdge) { player->trans.y = topEdge; }
+		if (player->trans.y >= bottomEdge) { player->trans.y = bottomEdge; }
+	}
+	else if (player->trans.y <= topEdge) {
+		player->trans.y = topEdge;
+		if (player->trans.x <= leftEdge) { player->trans.x = leftEdge; }
+		if (player->trans.x >= rightEdge) { player->trans.x = rightEdge; }
+	}
+	else if (player->trans.y >= bottomEdge) {
+		player->trans.y = bottomEdge;
+		if (player->trans.x <= leftEdge) { player->trans.x = leftEdge; }
+		if (player->trans.x >= rightEdge) { player->trans.x = rightEdge; }
+	}
+}
+
+//
+// Collision Control:
+// Rebuild the broad phase grids from this tick's enemy ships and enemy shots.
+// Entries are added fleet by fleet in pool order, so sorting a query result by
+// id gives the same order the fleets would have been scanned in.
+//
+void Simulation::buildCollisionGrids() {
+	shipGrid.clear();
+	shotGrid.clear();
+	shipRefs.clear();
+	shotRefs.clear();
+	for (int m = 0; m < enemy.size(); m++) {
+		EmitterPool &ships = enemy[m]->emitters;
+		for (int c = 0; c < ships.size(); c++) {
+			Emitter &ship = ships[c];
+			shipGrid.add(ship.trans.x, ship.trans.y, ship.prevTrans.x, ship.prevTrans.y);
+			shipRefs.push_back({ m, c, -1 });
+
+			// Shots move in a straight line, so their start is one step back.
+			SpriteSystem *shots = ship.sys;
+			for (int s = 0; s < shots->size(); s++) {
+				shotGrid.add(shots->px[s], shots->py[s], shots->px[s] - shots->vx[s] * shots->step, shots->py[s] - shots->vy[s] * shots->step);
+				shotRefs.push_back({ m, c, s });
+			}
+		}
+	}
+	shipGrid.build();
+	shotGrid.build();
+}
+
+// Create an explosion at a point.
+void Simulation::explode(ofVec3f pos, Tick now) {
+	// The pool spawns its debris at the end of the tick.
+	explosions.start(pos, now);
+}
+
+// Check collisions between player's shots and enemy ships.
+// Each shot can take down at most one ship per fleet. Tests are swept over
+// the step so fast shots can't pass through a ship between frames.
+// Create explosion upon hit.
+void Simulation::checkCollisions(Tick now) {
+	SpriteSystem *shots = player->sys;
+	float r = player->hitRadius();
+	for (int i = 0; i < shots->size(); i++) {
+		ofVec3f s = ofVec3f(shots->px[i], shots->py[i], 0);
+		ofVec3f last = s - ofVec3f(shots->vx[i], shots->vy[i], 0) * shots->step;
+		shipGrid.query(s.x, s.y, r + s.distance(last) + shipGrid.maxMove, candidates);
+		sort(candidates.begin(), candidates.end());
+		int lastFleet = -1;
+		for (int id : candidates) {
+			GridRef &ref = shipRefs[id];
+			Emitter &ship = enemy[ref.mama]->emitters[ref.child];
+			if (ref.mama == lastFleet || !ship.drawable || !shipGrid.sweep(id, last.x, last.y, s.x, s.y, r)) continue;
+			enemy[ref.mama]->hit(ref.child);
+			lastFleet = ref.mama;
+			play(assets.pop);
+			explode(s, now);
+			// Expire the sprite and add score.
+			shots->kill(i);
+			score += 1;
+		}
+	}
+}
+
+// Player collisions with enemy ships and enemy cannon shots.
+// A fleet can hit with at most one ship, and each ship with at most one shot.
+void Simulation::playerCollisions(Tick now) {
+	ofVec3f p = player->trans;
+	ofVec3f last = player->prevTrans;
+	float w = player->width / 2;
+	float move = p.distance(last);
+
+	// Check collision between player and enemy ships.
+	float reach = 0;
+	for (unique_ptr<MamaEmitter> &e : enemy) { reach = max(reach, e->shipRadius); }
+	shipGrid.query(p.x, p.y, reach + w + move + shipGrid.maxMove, candidates);
+	sort(candidates.begin(), candidates.end());
+	int lastFleet = -1;
+	for (int id : candidates) {
+		GridRef &ref = shipRefs[id];
+		MamaEmitter *e = enemy[ref.mama].get();
+		float r = e->shipRadius + w;
+		if (ref.mama == lastFleet || !e->emitters[ref.child].drawable || !shipGrid.sweep(id, last.x, last.y, p.x, p.y, r)) continue;
+		e->hit(ref.child);
+		lastFleet = ref.mama;
+		play(assets.playerHit);
+		lives -= 1;
+		explode(p, now);
+		// Game over condition.
+		if (lives == 0) {
+			bGameOver = true;
+		}
+	}
+
+	// Check collision between player and enemy shots.
+	reach = 0;
+	for (GridRef &ref : shipRefs) { reach = max(reach, enemy[ref.mama]->emitters[ref.child].hitRadius()); }
+	shotGrid.query(p.x, p.y, reach + w + move + shotGrid.maxMove, candidates);
+	sort(candidates.begin(), candidates.end());
+	int lastShip = -1;
+	lastFleet = -1;
+	for (int id : candidates) {
+		GridRef &ref = shotRefs[id];
+		Emitter &em = enemy[ref.mama]->emitters[ref.child];
+		float r = em.hitRadius() + w;
+		if ((ref.mama == lastFleet && ref.child == lastShip) || !shotGrid.sweep(id, last.x, last.y, p.x, p.y, r)) continue;
+		em.sys->remove(ref.shot);
+		lastFleet = ref.mama;
+		lastShip = ref.child;
+		play(assets.playerHit);
+		lives -= 1;
+		explode(p, now);
+		// Game over condition.
+		if (lives == 0) {
+			bGameOver = true;
+		}
+	}
+}
+
+// Collision between player and powerup, swept over the step.
+void Simulation::powerCollisions(Tick now) {
+	if (power.hidden) return;
+	ofVec3f d0 = power.prevTrans - player->prevTrans;
+	ofVec3f d1 = power.trans - player->trans;
+	if (sweptHit(d0.x, d0.y, d1.x, d1.y, power.hitRadius() + (player->width / 2))) {
+		power.hidden = true;
+		play(assets.powerHit);
+		player->hasPower = true;
+		player->powertime = now;
+	}
+}
+
+// FNV-1a over the raw bytes of a value.
+template <class T> static void hashValue(uint64_t &h, const T &v) {
+	const unsigned char *p = (const unsigned char *)&v;
+	for (int i = 0; i < sizeof(T); i++) {
+		h ^= p[i];
+		h *= 0x100000001B3ull;
+	}
+}
+
+// Hash of the level and path text the game was set up with. A recording
+// only plays back the same on the data it was made with.
+//
+uint64_t Simulation::dataHash() {
+	uint64_t h = 0xCBF29CE484222325ull;
+	for (char c : level.source) { hashValue(h, c); }
+	hashValue(h, '\0');
+	for (char c : paths.source) { hashValue(h, c); }
+	return h;
+}
+
+static void hashSprites(uint64_t &h, SpriteSystem *sys) {
+	hashValue(h, sys->size());
+	for (int i = 0; i < sys->size(); i++) {
+		hashValue(h, sys->px[i]);
+		hashValue(h, sys->py[i]);
+	}
+}
+
+// Hash of everything that shows up on screen: positions and counts of the
+// player, fleets, projectiles, power up and debris, plus score and lives.
+// Two runs that hash the same every tick played the same game.
+//
+uint64_t Simulation::stateHash() {
+	uint64_t h = 0xCBF29CE484222325ull;
+	hashValue(h, ticks);
+	hashValue(h, score);
+	hashValue(h, lives);
+	hashValue(h, player->trans.x);
+	hashValue(h, player->trans.y);
+	hashSprites(h, player->sys);
+	for (unique_ptr<MamaEmitter> &e : enemy) {
+		hashValue(h, e->emitters.size());
+		for (int i = 0; i < e->emitters.size(); i++) {
+			hashValue(h, e->emitters[i].trans.x);
+			hashValue(h, e->emitters[i].trans.y);
+			hashSprites(h, e->emitters[i].sys);
+		}
+	}
+	hashValue(h, power.hidden);
+	hashValue(h, power.trans.x);
+	hashValue(h, power.trans.y);
+	hashValue(h, explosions.size());
+	hashValue(h, explosions.debris.size());
+	for (Debris &d : explosions.debris) {
+		hashValue(h, d.position.x);
+		hashValue(h, d.position.y);
+	}
+	return h;
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "ofMain.h"
+#include "Assets.h"
+#include "CollisionGrid.h"
+#include "Emitter.h"
+#include "Explosion.h"
+#include "GameClock.h"
+#include "JobSystem.h"
+#include "Level.h"
+#include "PowerUp.h"
+#include "Profiler.h"
+#include "Random.h"
+#include "Sprite.h"
+#include "Viewport.h"
+
+// Modified by Michael Kang for CS134 Project 1.
+
+typedef enum { MoveStop, MoveLeft, MoveRight, MoveUp, MoveDown } MoveDir;
+
+// Player input for one tick, filled in by the host.
+struct TickInput {
+	bool keys[5] = { false, false, false, false, false };	// indexed by MoveDir
+	bool shoot = false;
+	ofVec3f drag;	// mouse drag since the last tick
+};
+
+// Textures and sounds handed to the game objects. A headless host leaves
+// these empty and everything still runs, it just can't be drawn or heard.
+struct SimAssets {
+	TextureHandle ship;
+	TextureHandle projectile;
+	TextureHandle enemyShip;
+	TextureHandle enemyProj;
+	TextureHandle explosion;
+	TextureHandle shield;
+	TextureHandle powerShield;
+
+	SoundHandle laserShot;
+	SoundHandle pop;
+	SoundHandle powerHit;
+	SoundHandle playerHit;
+};
+
+// Reference from a collision grid entry back to the entity it came from.
+struct GridRef {
+	int mama;	// index into Simulation::enemy
+	int child;	// dense index into the fleet's pool
+	int shot;	// sprite index in the child's system, -1 for ships
+};
+
+// The game itself: player, enemy fleets, power up, explosions and collisions.
+// It has no window. Its clock, random numbers and play field size come from
+// the host, so ofApp and the headless runner drive the same code.
+//
+class Simulation {
+public:
+	void setup(Clock *clock, uint64_t seed, Viewport view, const SimAssets &assets);
+	void start() { bGameStart = true; }
+	bool running() { return bGameStart && !bGameOver; }
+	void tick(const TickInput &input);
+	void buildTickGraph();
+	void applyInput(const TickInput &input, Tick now);
+	void updatePlayer(Tick now);
+	void addFleet(unique_ptr<MamaEmitter> e);
+	void updateFleets(Tick now);
+	void updateFleet(int i, Tick now);
+	void resolveCollisions(Tick now);
+	void setThreads(int n) { jobs.setup(n - 1); }	// 1 runs the whole tick in turn
+	void draw(float alpha);
+	void countEntities();
+	uint64_t stateHash();
+	uint64_t dataHash();
+
+	void buildCollisionGrids();
+	void checkCollisions(Tick now);
+	void playerCollisions(Tick now);
+	void powerCollisions(Tick now);
+	void explode(ofVec3f pos, Tick now);
+	void play(SoundHandle s);	// once per tick, by the host
+
+	// Movement limitations.
+	void keyMoveLimit(const TickInput &input);
+	void mouseMoveLimit();
+
+	// Host supplied services.
+	Clock *clock;
+	Viewport view;
+	SimAssets assets;
+
+	// Random streams, all derived from the seed. Each fleet has its own.
+	uint64_t seed;
+	Random debrisRng;
+	Random powerRng;
+
+	// Player object, the enemy ship template and the sprites they own.
+	SpriteSystem playerShots;
+	SpriteSystem enemyShots;	// the template's, never fired from
+	unique_ptr<Emitter> player;
+	unique_ptr<Emitter> enemy1;
+	vector<unique_ptr<MamaEmitter>> enemy;	// one per level fleet, in level order
+
+	// Paths the fleets fly, and the level saying who flies them when.
+	PathLibrary paths;
+	Level level;
+	Spawner spawner;
+
+	// Powerup.
+	PowerUp power;
+
+	// Explosions.
+	ExplosionPool explosions;
+
+	// Sprites are queued here while drawing and drawn per texture.
+	SpriteBatch batch;
+
+	// Collision broad phase.
+	CollisionGrid shipGrid;
+	CollisionGrid shotGrid;
+	vector<GridRef> shipRefs;
+	vector<GridRef> shotRefs;
+	vector<int> candidates;
+
+	// A tick's phases, run on these threads plus the one calling tick().
+	// Tasks read the tick's input and time from here.
+	JobSystem jobs;
+	TaskGraph frame;
+	const TickInput *tickInput = NULL;
+	Tick tickNow = 0;
+
+	// Sounds this tick asked for, each once. The host plays them after the
+	// tick, a headless one ignores them.
+	vector<SoundHandle> sounds;
+
+	// Profiler zone for each phase, each fleet's update, and fleet times.
+	vector<int> taskZones;
+	vector<int> fleetZones;
+	vector<double> fleetMs;
+
+	// Default fire direction.
+	ofVec3f defaultDir;
+
+	// Game state.
+	bool bGameStart = false;
+	bool bGameOver = false;
+	uint64_t ticks = 0;		// ticks run since the game started
+
+	// Store screen edges.
+	float leftEdge;
+	float rightEdge;
+	float topEdge;
+	float bottomEdge;
+	float moveSpeed = 300;	// arrow key movement in pixels/sec
+	float score = 0;
+	int lives = 10;
+};
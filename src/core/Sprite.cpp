@@ -0,0 +1,195 @@
+#include "Sprite.h"
+
+// Modified by Michael Kang for CS134 Project 1.
+
+BaseObject::BaseObject() {
+	trans = ofVec3f(0, 0, 0);
+	prevTrans = trans;
+	scale = ofVec3f(1, 1, 1);
+	rot = 0;
+}
+
+// Place the object without sweeping from its old position.
+void BaseObject::setPosition(glm::vec3 pos) {
+	trans = pos;
+	prevTrans = pos;
+}
+
+//
+// Basic Sprite Object.
+//
+Sprite::Sprite() {
+	speed = 0;
+	velocity = glm::vec3(0, 0, 0);
+	lifespan = -1;      // Lifespan of -1 => immortal.
+	birthtime = 0;
+	bSelected = false;
+	haveImage = false;
+	toRotate = false;
+	name = "UnamedSprite";
+	width = 60;
+	height = 80;
+}
+
+// Return a sprite's age in milliseconds.
+//
+float Sprite::age(Tick now) {
+	return (now - birthtime) * 1000.0f / TICK_RATE;
+}
+
+//  Set an image for the sprite. If you don't set one, a rectangle
+//  gets drawn.
+//
+void Sprite::setImage(TextureHandle img) {
+	image = img;
+	haveImage = true;
+	width = image->getWidth();
+	height = image->getHeight();
+}
+
+
+//  Render the sprite.
+//
+void Sprite::draw() {
+	ofSetColor(255, 255, 255, 255);
+
+	// Draw image centered and add in translation amount.
+	//
+	if (haveImage) {
+		image->draw(-width / 2.0 + trans.x, -height / 2.0 + trans.y);
+	}
+	else {
+		// In case no image is supplied, draw something.
+		// 
+		ofSetColor(255, 0, 0);
+		ofDrawRectangle(-width / 2.0 + trans.x, -height / 2.0 + trans.y, width, height);
+	}
+}
+
+//
+// Sprite System:
+// Add a Sprite to the Sprite System.
+//
+void SpriteSystem::add(Sprite s) {
+	spawn(s.trans, s.velocity, s.lifespan, s.birthtime);
+}
+
+// Append a sprite to the packed arrays. Storage is reserved up front and never
+// shrinks, so steady state spawning does not allocate. The lifespan is in ms,
+// rounded to whole ticks.
+//
+void SpriteSystem::spawn(glm::vec3 pos, glm::vec3 vel, float lifespan, Tick now) {
+	px.push_back(pos.x);
+	py.push_back(pos.y);
+	vx.push_back(vel.x);
+	vy.push_back(vel.y);
+	expiry.push_back(lifespan == -1 ? TICK_NEVER : now + ticksFor(lifespan));
+}
+
+// Remove a sprite from the sprite system by moving the last sprite into its
+// slot. Order of sprites in a system does not matter.
+//
+void SpriteSystem::remove(int i) {
+	int last = px.size() - 1;
+	px[i] = px[last]; px.pop_back();
+	py[i] = py[last]; py.pop_back();
+	vx[i] = vx[last]; vx.pop_back();
+	vy[i] = vy[last]; vy.pop_back();
+	expiry[i] = expiry[last]; expiry.pop_back();
+}
+
+// Drop all sprites but keep the storage for reuse.
+//
+void SpriteSystem::clear() {
+	px.clear();
+	py.clear();
+	vx.clear();
+	vy.clear();
+	expiry.clear();
+}
+
+void SpriteSystem::reserve(int n) {
+	px.reserve(n);
+	py.reserve(n);
+	vx.reserve(n);
+	vy.reserve(n);
+	expiry.reserve(n);
+}
+
+
+//  Update the SpriteSystem by checking which sprites have exceeded their
+//  lifespan (and deleting).  Also the sprite is moved to it's next
+//  location based on velocity and direction.
+//
+void SpriteSystem::update(Tick now) {
+	if (px.size() == 0) return;
+
+	// Compact live sprites to the front of the arrays in a single pass,
+	// then drop the expired tail.
+	//
+	int n = px.size();
+	int live = 0;
+	for (int i = 0; i < n; i++) {
+		if (now > expiry[i]) continue;
+		px[live] = px[i];
+		py[live] = py[i];
+		vx[live] = vx[i];
+		vy[live] = vy[i];
+		expiry[live] = expiry[i];
+		live++;
+	}
+	px.resize(live);
+	py.resize(live);
+	vx.resize(live);
+	vy.resize(live);
+	expiry.resize(live);
+
+	//  Move sprite.
+	//
+	float dt = TICK_DT;
+	step = dt;
+	for (int i = 0; i < live; i++) {
+		px[i] += vx[i] * dt;
+		py[i] += vy[i] * dt;
+	}
+}
+
+//  Render all the sprites, backed off to where they were alpha of the way
+//  through the last tick.
+//
+void SpriteSystem::draw(SpriteBatch &batch, float alpha) {
+	float back = step * (1 - alpha);
+	if (image == NULL) {
+		// In case no image is supplied, draw something.
+		//
+		Profiler::get().count(CountDrawCalls, px.size());
+		ofSetColor(255, 0, 0);
+		for (int i = 0; i < px.size(); i++) {
+			ofDrawRectangle(px[i] - vx[i] * back - 30, py[i] - vy[i] * back - 40, 60, 80);
+		}
+		return;
+	}
+
+	// Queue the image centered on each sprite.
+	//
+	float w = image->getWidth();
+	float h = image->getHeight();
+	for (int i = 0; i < px.size(); i++) {
+		batch.add(image, px[i] - vx[i] * back, py[i] - vy[i] * back, w, h);
+	}
+}
+
+// Collision detection. Removes the first sprite within dist of the point.
+bool SpriteSystem::removeNear(ofVec3f point, float dist) {
+	int n = px.size();
+	if (n == 0) return false;
+	mask.resize((n + 31) / 32);
+	if (collidePoints(point.x, point.y, dist, &px[0], &py[0], n, &mask[0]) == 0) return false;
+	for (int w = 0; w < mask.size(); w++) {
+		if (mask[w]) {
+			remove(w * 32 + lowestBit(mask[w]));
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "ofMain.h"
+#include "Assets.h"
+#include "CollideKernel.h"
+#include "GameClock.h"
+#include "Profiler.h"
+#include "SpriteBatch.h"
+
+// Modified by Michael Kang for CS134 Project 1.
+
+// Frame rate that hit radii were tuned at. Collisions are swept, so hits no
+// longer depend on the actual frame rate.
+const float TUNED_FRAMERATE = 60.0;
+
+// This is a base object that all drawable object inherit from
+// It is possible this will be replaced by ofNode when we move to 3D
+//
+class BaseObject {
+public:
+	BaseObject();
+
+	void setPosition(glm::vec3 position);
+
+	glm::mat4 getMatrix() { return getMatrix(trans); }
+	glm::mat4 getMatrix(glm::vec3 pos) {
+		glm::mat4 m = glm::translate(glm::mat4(1.0), pos);
+		glm::mat4 M = glm::rotate(m, glm::radians(rot), glm::vec3(0, 0, 1));
+		return M;
+	}
+
+	// Position between the last two ticks, alpha is how far into the current one.
+	glm::vec3 lerpTrans(float alpha) { return prevTrans + (trans - prevTrans) * alpha; }
+
+	glm::vec3 trans, scale;
+	glm::vec3 prevTrans;	// position at the start of the last step
+	float rot;
+	bool bSelected;
+};
+
+// General Sprite class.  (similar to a Particle)
+//
+class Sprite : public BaseObject {
+public:
+	Sprite();
+
+	void draw();
+	void setImage(TextureHandle);
+	float age(Tick now);
+
+	ofVec3f velocity; // in pixels/sec
+
+	float speed;		// in pixels/sec
+	Tick birthtime;		// tick it was born on
+	float lifespan;		// time in ms
+	float width, height;
+	float rotate;
+
+	string name;
+	TextureHandle image;
+	bool haveImage;
+	bool toRotate;
+};
+
+// Manages all Sprites in a system.  You can create multiple systems.
+// Projectiles are stored as packed arrays (structure of arrays) since only
+// position, velocity and expiry are touched each frame. All sprites in a
+// system share the same image.
+//
+class SpriteSystem {
+public:
+	SpriteSystem() { reserve(64); }
+
+	void add(Sprite);
+	void spawn(glm::vec3 pos, glm::vec3 vel, float lifespan, Tick now);
+	void remove(int);
+	void kill(int i) { expiry[i] = 0; }
+	void reserve(int n);
+	void clear();
+	void setImage(TextureHandle img) { image = img; }
+	int size() { return px.size(); }
+	void update(Tick now);
+	void draw(SpriteBatch &batch, float alpha = 1);
+	bool removeNear(ofVec3f point, float dist);
+	ofVec3f position;
+
+	// Packed sprite data.
+	vector<float> px, py;	// position
+	vector<float> vx, vy;	// velocity in pixels/sec
+	vector<Tick> expiry;	// last tick alive, TICK_NEVER => immortal
+	float step = 0;			// dt of the last update in seconds
+	vector<uint32_t> mask;	// collision kernel hit bits
+
+	TextureHandle image;	// shared by all sprites in the system
+};
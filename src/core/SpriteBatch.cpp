@@ -0,0 +1,59 @@
+#include "SpriteBatch.h"
+
+void SpriteBatch::begin() {
+	for (Batch &b : batches) {
+		b.mesh.clear();
+		b.quads = 0;
+	}
+	quads = 0;
+}
+
+SpriteBatch::Batch &SpriteBatch::batchFor(const TextureHandle &tex) {
+	for (Batch &b : batches) {
+		if (b.texture == tex->texture) return b;
+	}
+	batches.push_back(Batch());
+	Batch &b = batches.back();
+	b.texture = tex->texture;
+	b.mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+	b.mesh.setUsage(GL_DYNAMIC_DRAW);
+	return b;
+}
+
+void SpriteBatch::add(const TextureHandle &tex, float x, float y, float w, float h, float deg, float alpha) {
+	Batch &b = batchFor(tex);
+	float c = 1, s = 0;
+	if (deg != 0) {
+		c = cos(ofDegToRad(deg));
+		s = sin(ofDegToRad(deg));
+	}
+	float hw = w / 2, hh = h / 2;
+	float cx[4] = { -hw, hw, hw, -hw };
+	float cy[4] = { -hh, -hh, hh, hh };
+	ofFloatColor tint(1, 1, 1, alpha / 255.0);
+
+	ofIndexType first = b.mesh.getNumVertices();
+	for (int i = 0; i < 4; i++) {
+		b.mesh.addVertex(glm::vec3(x + cx[i] * c - cy[i] * s, y + cx[i] * s + cy[i] * c, 0));
+		b.mesh.addTexCoord(tex->uv[i]);
+		b.mesh.addColor(tint);
+	}
+	ofIndexType idx[6] = { first, first + 1, first + 2, first, first + 2, first + 3 };
+	b.mesh.addIndices(idx, 6);
+	b.quads++;
+	quads++;
+}
+
+// Draw each texture's quads in one call.
+void SpriteBatch::end() {
+	drawCalls = 0;
+	ofSetColor(255, 255, 255, 255);
+	for (Batch &b : batches) {
+		if (b.quads == 0) continue;
+		b.texture->bind();
+		b.mesh.draw();
+		b.texture->unbind();
+		drawCalls++;
+	}
+	Profiler::get().count(CountDrawCalls, drawCalls);
+}
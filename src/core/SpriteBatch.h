@@ -0,0 +1,39 @@
+#pragma once
+
+#include "ofMain.h"
+#include "Assets.h"
+#include "Profiler.h"
+
+// Collects textured quads over a frame and draws all the quads that share a
+// texture with a single mesh, one draw call per texture instead of one per
+// sprite. Images packed in the same atlas share a texture. Quads for a
+// texture keep the order they were added in; textures are drawn in the order
+// they were first used. Only plain vertex, color and texture coordinate
+// arrays are used, so any GL 2.1 driver (including Mesa's llvmpipe) can draw
+// it.
+//
+class SpriteBatch {
+public:
+	void begin();
+	// Quad of w x h centered on (x, y), rotated by deg, tinted by alpha (0-255).
+	void add(const TextureHandle &tex, float x, float y, float w, float h, float deg = 0, float alpha = 255);
+	// Same, sized to the texture and opaque.
+	void add(const TextureHandle &tex, float x, float y, float deg = 0) {
+		add(tex, x, y, tex->getWidth(), tex->getHeight(), deg);
+	}
+	void end();
+
+	int quads = 0;		// added since begin()
+	int drawCalls = 0;	// issued by the last end()
+
+private:
+	struct Batch {
+		shared_ptr<ofTexture> texture;	// images from one atlas share a batch
+		ofVboMesh mesh;
+		int quads = 0;
+	};
+	Batch &batchFor(const TextureHandle &tex);
+
+	// Batches are kept between frames so their meshes keep their storage.
+	vector<Batch> batches;
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "GameClock.h"
+
+using namespace std;
+
+// Hierarchical timing wheel: items are scheduled for a tick and handed back
+// once the wheel is advanced past it. Level 0 has a slot for each of the next
+// 64 ticks, each level above covers 64 times the span of the one below, and
+// a level's slot is spread over the level below when the time comes. Items
+// due further out than the top level wait in an overflow list. Scheduling is
+// O(1) and advancing costs the items that expire (or cascade), not the items
+// alive, plus a slot check per tick.
+//
+template<class T>
+class TimingWheel {
+public:
+	static const int BITS = 6;
+	static const int SLOTS = 1 << BITS;
+	static const int LEVELS = 4;
+
+	// Due at tick, or at the next tick advanced over if that has passed.
+	void schedule(Tick tick, const T &item) {
+		if (tick < current) { tick = current; }
+		place(Entry{ tick, item });
+		count++;
+	}
+
+	// Hand every item due by now to expire(item), in tick order.
+	template<class F>
+	void advance(Tick now, F expire) {
+		for (; current <= now; current++) {
+			if (count == 0) {
+				current = now + 1;
+				break;
+			}
+			// Entering a new span of a level above, spread its slot out.
+			if ((current & (((Tick)1 << (BITS * LEVELS)) - 1)) == 0) { cascade(overflow); }
+			for (int l = LEVELS - 1; l > 0; l--) {
+				if ((current & (((Tick)1 << (BITS * l)) - 1)) == 0) { cascade(slots[l][(current >> (BITS * l)) & (SLOTS - 1)]); }
+			}
+			vector<Entry> &slot = slots[0][current & (SLOTS - 1)];
+			if (slot.empty()) continue;
+			due.swap(slot);
+			count -= due.size();
+			for (Entry &e : due) { expire(e.item); }
+			due.clear();
+		}
+	}
+
+	void clear() {
+		for (int l = 0; l < LEVELS; l++) {
+			for (int s = 0; s < SLOTS; s++) { slots[l][s].clear(); }
+		}
+		overflow.clear();
+		count = 0;
+		current = 0;
+	}
+
+	int size() { return count; }
+
+private:
+	struct Entry {
+		Tick tick;
+		T item;
+	};
+
+	// Put an entry on the lowest level whose span (as of the current tick)
+	// reaches it.
+	void place(const Entry &e) {
+		for (int l = 0; l < LEVELS; l++) {
+			if ((e.tick >> (BITS * (l + 1))) == (current >> (BITS * (l + 1)))) {
+				slots[l][(e.tick >> (BITS * l)) & (SLOTS - 1)].push_back(e);
+				return;
+			}
+		}
+		overflow.push_back(e);
+	}
+
+	void cascade(vector<Entry> &from) {
+		if (from.empty()) return;
+		moving.swap(from);
+		for (Entry &e : moving) { place(e); }
+		moving.clear();
+	}
+
+	vector<Entry> slots[LEVELS][SLOTS];
+	vector<Entry> overflow;
+	vector<Entry> due, moving;	// scratch, kept to reuse their storage
+	Tick current = 0;			// next tick to advance over
+	int count = 0;
+};
@@ -0,0 +1,7 @@
+#pragma once
+
+// Size of the play field, supplied by the host instead of read from the window.
+struct Viewport {
+	float width = 375;
+	float height = 667;
+};